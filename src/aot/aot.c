@@ -0,0 +1,568 @@
+/**
+ * @file   aot.c
+ * @brief  This file contains the functions of the ahead of time compiler.  A
+ * program is translated to C, one function per statement, which the system C
+ * compiler turns into a shared object that is loaded with dlopen.  Shared
+ * objects are cached under the hash of the C, so a script that has not
+ * changed is only compiled once.  INT and DOUBLE operations are done inline
+ * and anything else (STRINGs, mixed types, errors) calls back into the kernel
+ * tables of ast_result, so compiled code behaves as the interpreter does.
+ * @author Matthew C. Lindeman
+ * @date   October 05, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <limits.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "include/aot.h"
+
+/** The functions compiled code calls back into */
+const aot_host AOT_HOST = {
+  .binary = ast_result_binary,
+  .unary = ast_result_unary,
+  .load = aot_load,
+  .assign = ast_result_assign_slot,
+  .string = aot_string,
+};
+
+/** The start of every translation: the types compiled code shares with the
+ * interpreter (kept in step with var_type, binary_op, unary_op, ast_result and
+ * aot_host) and the inline INT and DOUBLE cases of the operations, which wrap
+ * and truncate INTs as int_add, ..., double_to_int do (the host takes the
+ * divisions by 0 and -1) */
+const char * AOT_PREAMBLE =
+  "#include <math.h>\n"
+  "#include <stddef.h>\n"
+  "typedef enum {DOUBLE, INT, STRING} var_type;\n"
+  "typedef enum {BINARY_ADD, BINARY_SUB, BINARY_MUL, BINARY_DIV, BINARY_POW,\n"
+  "  BINARY_EQ, BINARY_GT_EQ, BINARY_GT, BINARY_LT_EQ, BINARY_LT,\n"
+  "  QTY_BINARY_OPS} binary_op;\n"
+  "typedef enum {UNARY_SIN, UNARY_ARC_SIN, UNARY_COS, UNARY_ARC_COS,\n"
+  "  UNARY_TAN, UNARY_ARC_TAN, UNARY_LOG, QTY_UNARY_OPS} unary_op;\n"
+  "typedef struct SYMBOL_TABLE_T symbol_table;\n"
+  "typedef struct SHARED_STRING_T shared_string;\n"
+  "typedef struct AST_RESULT_T {\n"
+  "  union {\n"
+  "    long long int_value;\n"
+  "    double double_value;\n"
+  "    shared_string * string_value;\n"
+  "  } value;\n"
+  "  var_type type;\n"
+  "} ast_result;\n"
+  "typedef struct AOT_HOST_T {\n"
+  "  ast_result (*binary)(binary_op, ast_result, ast_result);\n"
+  "  ast_result (*unary)(unary_op, ast_result);\n"
+  "  ast_result (*load)(symbol_table **, int, const char *, int);\n"
+  "  ast_result (*assign)(int, ast_result, symbol_table **);\n"
+  "  ast_result (*string)(const char *, size_t);\n"
+  "} aot_host;\n"
+  "const unsigned long ao_abi[] = {sizeof(ast_result), sizeof(aot_host),\n"
+  "  QTY_BINARY_OPS, QTY_UNARY_OPS};\n"
+  "static ast_result ao_int(long long v) {\n"
+  "  ast_result r;\n"
+  "  r.value.int_value = v;\n"
+  "  r.type = INT;\n"
+  "  return r;\n"
+  "}\n"
+  "static ast_result ao_double(double v) {\n"
+  "  ast_result r;\n"
+  "  r.value.double_value = v;\n"
+  "  r.type = DOUBLE;\n"
+  "  return r;\n"
+  "}\n"
+  "static ast_result ao_bits(unsigned long long bits) {\n"
+  "  union {unsigned long long u; double d;} v;\n"
+  "  v.u = bits;\n"
+  "  return ao_double(v.d);\n"
+  "}\n"
+  "static long long ao_to_int(double v) {\n"
+  "  if(!(v >= -9223372036854775808.0 && v < 9223372036854775808.0))\n"
+  "    return -9223372036854775807LL - 1;\n"
+  "  return (long long)v;\n"
+  "}\n"
+  "#define AO_BOTH(t) (a.type == t && b.type == t)\n"
+  "#define AO_ARITHMETIC(NAME, OP, OPERATOR)\\\n"
+  "static ast_result ao_##NAME(const aot_host * h, ast_result a,\\\n"
+  "    ast_result b) {\\\n"
+  "  if(AO_BOTH(INT))\\\n"
+  "    return ao_int((long long)((unsigned long long)a.value.int_value\\\n"
+  "          OP (unsigned long long)b.value.int_value));\\\n"
+  "  if(AO_BOTH(DOUBLE))\\\n"
+  "    return ao_double(a.value.double_value OP b.value.double_value);\\\n"
+  "  return h->binary(OPERATOR, a, b);\\\n"
+  "}\n"
+  "#define AO_COMPARISON(NAME, OP, OPERATOR)\\\n"
+  "static ast_result ao_##NAME(const aot_host * h, ast_result a,\\\n"
+  "    ast_result b) {\\\n"
+  "  if(AO_BOTH(INT))\\\n"
+  "    return ao_int(a.value.int_value OP b.value.int_value ? 1 : 0);\\\n"
+  "  if(AO_BOTH(DOUBLE))\\\n"
+  "    return ao_int(a.value.double_value OP b.value.double_value ? 1 : 0);\\\n"
+  "  return h->binary(OPERATOR, a, b);\\\n"
+  "}\n"
+  "#define AO_FUNCTION(NAME, FN, FUNCTION)\\\n"
+  "static ast_result ao_##NAME(const aot_host * h, ast_result a) {\\\n"
+  "  if(a.type == INT)\\\n"
+  "    return ao_int(ao_to_int(FN(a.value.int_value)));\\\n"
+  "  if(a.type == DOUBLE)\\\n"
+  "    return ao_double(FN(a.value.double_value));\\\n"
+  "  return h->unary(FUNCTION, a);\\\n"
+  "}\n"
+  "AO_ARITHMETIC(addition, +, BINARY_ADD)\n"
+  "AO_ARITHMETIC(subtraction, -, BINARY_SUB)\n"
+  "AO_ARITHMETIC(multiplication, *, BINARY_MUL)\n"
+  "AO_COMPARISON(equality, ==, BINARY_EQ)\n"
+  "AO_COMPARISON(gteq, >=, BINARY_GT_EQ)\n"
+  "AO_COMPARISON(gt, >, BINARY_GT)\n"
+  "AO_COMPARISON(lteq, <=, BINARY_LT_EQ)\n"
+  "AO_COMPARISON(lt, <, BINARY_LT)\n"
+  "AO_FUNCTION(sin, sin, UNARY_SIN)\n"
+  "AO_FUNCTION(arc_sin, asin, UNARY_ARC_SIN)\n"
+  "AO_FUNCTION(cos, cos, UNARY_COS)\n"
+  "AO_FUNCTION(arc_cos, acos, UNARY_ARC_COS)\n"
+  "AO_FUNCTION(tan, tan, UNARY_TAN)\n"
+  "AO_FUNCTION(arc_tan, atan, UNARY_ARC_TAN)\n"
+  "AO_FUNCTION(log, log, UNARY_LOG)\n"
+  "static ast_result ao_division(const aot_host * h, ast_result a,\n"
+  "    ast_result b) {\n"
+  "  if(AO_BOTH(INT) && b.value.int_value != 0 && b.value.int_value != -1)\n"
+  "    return ao_int(a.value.int_value / b.value.int_value);\n"
+  "  if(AO_BOTH(DOUBLE))\n"
+  "    return ao_double(a.value.double_value / b.value.double_value);\n"
+  "  return h->binary(BINARY_DIV, a, b);\n"
+  "}\n"
+  "static ast_result ao_power(const aot_host * h, ast_result a,\n"
+  "    ast_result b) {\n"
+  "  if(AO_BOTH(INT))\n"
+  "    return ao_int(ao_to_int(pow(a.value.int_value, b.value.int_value)));\n"
+  "  if(AO_BOTH(DOUBLE))\n"
+  "    return ao_double(pow(a.value.double_value, b.value.double_value));\n"
+  "  return h->binary(BINARY_POW, a, b);\n"
+  "}\n";
+
+/**
+ * This function compiles a program ahead of time (or finds it in the cache)
+ * and loads it.
+ * @param      prog - The program (parsed, its variables resolved).
+ * @param cache_dir - The directory compiled programs are kept in.
+ * @return        m - The loaded program, NULL if it could not be translated,
+ *                    compiled or loaded (the interpreter runs it instead).
+ */
+aot_module * aot_compile(program * prog, const char * cache_dir) {
+  aot_buffer out = {0};
+  aot_module * m = NULL;
+  FILE * fp = NULL;
+  size_t size = strlen(cache_dir) + 64;
+  char * so_path = malloc(size);
+  char * c_path = malloc(size);
+  out.cap = AOT_INITIAL_TEXT;
+  out.text = malloc(out.cap);
+  if(aot_translate(prog, &out) && !aot_make_dirs(cache_dir)
+      && aot_is_private(cache_dir, 1)) {
+    snprintf(so_path, size, "%s/%016llx.so", cache_dir,
+        aot_hash(out.text, out.len));
+    m = aot_open(so_path, prog->qty_statements);
+    if(m) {
+      m->was_cached = 1;
+    } else {
+      // Built under names of this process, then renamed into the cache so
+      // that no other process sees half a shared object
+      snprintf(c_path, size, "%s/%016llx.%ld.c", cache_dir,
+          aot_hash(out.text, out.len), (long)getpid());
+      fp = fopen(c_path, "w");
+      if(fp) {
+        fwrite(out.text, 1, out.len, fp);
+        fclose(fp);
+        m = aot_build(c_path, so_path) ? NULL
+          : aot_open(so_path, prog->qty_statements);
+        remove(c_path);
+      }
+    }
+  }
+  free(out.text);
+  free(so_path);
+  free(c_path);
+  return m;
+}
+
+/**
+ * This function translates a program to C.
+ * @param prog - The program.
+ * @param  out - The buffer the C is appended to.
+ * @return  .\ - 1 if every statement could be translated, 0 otherwise.
+ */
+int aot_translate(program * prog, aot_buffer * out) {
+  int result = 0;
+  aot_emit_bytes(out, AOT_PREAMBLE, strlen(AOT_PREAMBLE));
+  for(int i = 0; i < prog->qty_statements; i++) {
+    aot_printf(out, "static ast_result ao_line_%d(const aot_host * h,"
+        " symbol_table ** st) {\n", i);
+    out->qty_temps = 0;
+    result = aot_emit_node(out, prog->statements[i].abstree);
+    if(result == -1)
+      return 0;
+    aot_printf(out, "  return t%d;\n}\n", result);
+  }
+  aot_printf(out, "ast_result (* const ao_lines[])(const aot_host *,"
+      " symbol_table **) = {\n");
+  for(int i = 0; i < prog->qty_statements; i++)
+    aot_printf(out, "  ao_line_%d,\n", i);
+  aot_printf(out, "  NULL\n};\n");
+  return 1;
+}
+
+/**
+ * This function emits the code of a node into a new temporary, after the
+ * code of its children (left to right).
+ * @param     out - The buffer the C is appended to.
+ * @param abstree - The node.
+ * @return      t - The number of the temporary holding the value of the
+ *                  node, -1 if it can not be translated.
+ */
+int aot_emit_node(aot_buffer * out, ast * abstree) {
+  int lhs = -1;
+  int rhs = -1;
+  int t = -1;
+  const char * name = NULL;
+  union {
+    double d;
+    unsigned long long u;
+  } bits;
+  switch(abstree->value.type) {
+    case TOKEN_PLUS:      name = "addition";       break;
+    case TOKEN_MINUS:     name = "subtraction";    break;
+    case TOKEN_MULT:      name = "multiplication"; break;
+    case TOKEN_DIV:       name = "division";       break;
+    case TOKEN_POWER:     name = "power";          break;
+    case TOKEN_EQUALITY:  name = "equality";       break;
+    case TOKEN_GT_EQ:     name = "gteq";           break;
+    case TOKEN_GT:        name = "gt";             break;
+    case TOKEN_LT_EQ:     name = "lteq";           break;
+    case TOKEN_LT:        name = "lt";             break;
+    case TOKEN_SIN:       name = "sin";            break;
+    case TOKEN_ARC_SIN:   name = "arc_sin";        break;
+    case TOKEN_COS:       name = "cos";            break;
+    case TOKEN_ARC_COS:   name = "arc_cos";        break;
+    case TOKEN_TAN:       name = "tan";            break;
+    case TOKEN_ARC_TAN:   name = "arc_tan";        break;
+    case TOKEN_LOG:       name = "log";            break;
+    default:                                       break;
+  }
+  if(abstree->value.type == TOKEN_ASSIGN) {
+    if(abstree->slot == -1 || (rhs = aot_emit_node(out, abstree->children[1]))
+        == -1)
+      return -1;
+    t = out->qty_temps++;
+    aot_printf(out, "  ast_result t%d = h->assign(%d, t%d, st);\n", t,
+        abstree->slot, rhs);
+    return t;
+  }
+  if(name && abstree->no_children == 2) {
+    if((lhs = aot_emit_node(out, abstree->children[0])) == -1
+        || (rhs = aot_emit_node(out, abstree->children[1])) == -1)
+      return -1;
+    t = out->qty_temps++;
+    aot_printf(out, "  ast_result t%d = ao_%s(h, t%d, t%d);\n", t, name, lhs,
+        rhs);
+    return t;
+  }
+  if(name && abstree->no_children == 1) {
+    if((lhs = aot_emit_node(out, abstree->children[0])) == -1)
+      return -1;
+    t = out->qty_temps++;
+    aot_printf(out, "  ast_result t%d = ao_%s(h, t%d);\n", t, name, lhs);
+    return t;
+  }
+  switch(abstree->value.type) {
+    case TOKEN_INT:
+      t = out->qty_temps++;
+      if(abstree->value.value.int_value == LLONG_MIN)
+        aot_printf(out, "  ast_result t%d = ao_int(-%lldLL - 1);\n", t,
+            LLONG_MAX);
+      else
+        aot_printf(out, "  ast_result t%d = ao_int(%lldLL);\n", t,
+            abstree->value.value.int_value);
+      return t;
+    case TOKEN_DOUBLE:
+      // The bits of the double, so that every value (inf and nan too) is
+      // exactly the one the interpreter has
+      t = out->qty_temps++;
+      bits.d = abstree->value.value.double_value;
+      aot_printf(out, "  ast_result t%d = ao_bits(0x%016llxULL);\n", t,
+          bits.u);
+      return t;
+    case TOKEN_STRING:
+      t = out->qty_temps++;
+      aot_printf(out, "  ast_result t%d = h->string(\"", t);
+      for(size_t i = 0; i < abstree->value.len; i++)
+        aot_printf(out, "\\%03o", (unsigned char)abstree->value.t_literal[i]);
+      aot_printf(out, "\", %zu);\n", abstree->value.len);
+      return t;
+    case TOKEN_VAR:
+      if(abstree->slot == -1)
+        return -1;
+      t = out->qty_temps++;
+      aot_printf(out, "  ast_result t%d = h->load(st, %d, \"", t,
+          abstree->slot);
+      for(size_t i = 0; i < abstree->value.len; i++)
+        aot_printf(out, "\\%03o", (unsigned char)abstree->value.t_literal[i]);
+      aot_printf(out, "\", %d);\n", (int)abstree->value.len);
+      return t;
+    default:
+      return -1;
+  }
+}
+
+/**
+ * This function appends bytes to the C being emitted.
+ * @param   out - The buffer.
+ * @param bytes - The bytes.
+ * @param   len - The number of bytes.
+ * @return  N/a
+ */
+void aot_emit_bytes(aot_buffer * out, const char * bytes, size_t len) {
+  if(out->len + len + 1 > out->cap) {
+    while(out->len + len + 1 > out->cap)
+      out->cap *= 2;
+    out->text = realloc(out->text, out->cap);
+  }
+  memcpy(out->text + out->len, bytes, len);
+  out->len += len;
+  out->text[out->len] = '\0';
+}
+
+/**
+ * This function appends formatted text to the C being emitted.
+ * @param out - The buffer.
+ * @param fmt - The format (as printf).
+ * @return N/a
+ */
+void aot_printf(aot_buffer * out, const char * fmt, ...) {
+  va_list args;
+  int len = 0;
+  va_start(args, fmt);
+  len = vsnprintf(NULL, 0, fmt, args);
+  va_end(args);
+  if(out->len + len + 1 > out->cap) {
+    while(out->len + len + 1 > out->cap)
+      out->cap *= 2;
+    out->text = realloc(out->text, out->cap);
+  }
+  va_start(args, fmt);
+  vsnprintf(out->text + out->len, len + 1, fmt, args);
+  va_end(args);
+  out->len += len;
+}
+
+/**
+ * This function hashes text (64 bit FNV-1a).
+ * @param text - The text.
+ * @param  len - The length of the text.
+ * @return hash - The hash.
+ */
+unsigned long long aot_hash(const char * text, size_t len) {
+  unsigned long long hash = 14695981039346656037ULL;
+  for(size_t i = 0; i < len; i++) {
+    hash ^= (unsigned char)text[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * This function gives the directory compiled programs are cached in:
+ * $AO_CACHE_DIR, else $XDG_CACHE_HOME/ao, else $HOME/.cache/ao.  There is no
+ * shared fallback (e.g. under /tmp) as whoever can write to the cache can
+ * run code in the interpreter.
+ * @param N/a
+ * @return dir - The directory (to be freed by the caller), NULL if none of
+ *               the variables is set.
+ */
+char * aot_cache_dir(void) {
+  const char * env = NULL;
+  char * dir = NULL;
+  size_t size = 0;
+  if((env = getenv("AO_CACHE_DIR")) && *env)
+    return strdup(env);
+  if((env = getenv("XDG_CACHE_HOME")) && *env) {
+    size = strlen(env) + 4;
+    dir = malloc(size);
+    snprintf(dir, size, "%s/ao", env);
+  } else if((env = getenv("HOME")) && *env) {
+    size = strlen(env) + 11;
+    dir = malloc(size);
+    snprintf(dir, size, "%s/.cache/ao", env);
+  }
+  return dir;
+}
+
+/**
+ * This function creates a directory and the directories above it that do
+ * not exist yet.  The directory itself is created private to the user.
+ * @param path - The directory.
+ * @return  .\ - 0 if the directory exists now, -1 otherwise.
+ */
+int aot_make_dirs(const char * path) {
+  char * copy = strdup(path);
+  int result = 0;
+  for(char * c = copy + 1; *c && !result; c++) {
+    if(*c == '/') {
+      *c = '\0';
+      if(mkdir(copy, 0755) && errno != EEXIST)
+        result = -1;
+      *c = '/';
+    }
+  }
+  if(!result && mkdir(copy, 0700) && errno != EEXIST)
+    result = -1;
+  free(copy);
+  return result;
+}
+
+/**
+ * This function determines whether a file (or directory) of the cache can
+ * only have been written by the user: it is owned by the user and neither
+ * its group nor others can write to it.
+ * @param   path - The file or directory.
+ * @param is_dir - Whether it must be a directory (a regular file otherwise).
+ * @return    .\ - 1 if it is private, 0 otherwise (or if it does not exist).
+ */
+int aot_is_private(const char * path, int is_dir) {
+  struct stat sb;
+  if(stat(path, &sb)
+      || (is_dir ? !S_ISDIR(sb.st_mode) : !S_ISREG(sb.st_mode)))
+    return 0;
+  return sb.st_uid == getuid() && !(sb.st_mode & (S_IWGRP | S_IWOTH));
+}
+
+/**
+ * This function compiles the C of a program to a shared object with the
+ * system C compiler ($CC, else cc).  The shared object is made private to the
+ * user whatever the umask, as aot_open only loads private ones.
+ * @param  c_path - The C.
+ * @param so_path - The shared object (replaced once it is complete).
+ * @return     .\ - 0 if the shared object was built, -1 otherwise.
+ */
+int aot_build(const char * c_path, const char * so_path) {
+  const char * cc = getenv("CC") && *getenv("CC") ? getenv("CC") : "cc";
+  size_t size = strlen(cc) + 2 * strlen(so_path) + strlen(c_path) + 128;
+  char * command = NULL;
+  char * tmp_path = NULL;
+  int result = -1;
+  // The paths are quoted for the shell, which a quote in them would break
+  if(strchr(c_path, '\'') || strchr(so_path, '\''))
+    return -1;
+  command = malloc(size);
+  tmp_path = malloc(size);
+  snprintf(tmp_path, size, "%s.%ld", so_path, (long)getpid());
+  snprintf(command, size, "%s -std=c99 -O2 -shared -fPIC -o '%s' '%s' -lm",
+      cc, tmp_path, c_path);
+  if(system(command)) {
+    fprintf(stderr, "[AOT_BUILD]: `%s` failed, interpreting instead\n",
+        command);
+    remove(tmp_path);
+  } else if(!chmod(tmp_path, 0700) && !rename(tmp_path, so_path)) {
+    result = 0;
+  }
+  free(command);
+  free(tmp_path);
+  return result;
+}
+
+/**
+ * This function loads a compiled program.
+ * @param    so_path - The shared object.
+ * @param qty_lines - The number of statements the program has.
+ * @return         m - The loaded program, NULL if there is no such shared
+ *                     object, it is not private to the user or it does not
+ *                     match this interpreter.
+ */
+aot_module * aot_open(const char * so_path, int qty_lines) {
+  void * handle = NULL;
+  const unsigned long * abi = NULL;
+  aot_line * lines = NULL;
+  aot_module * m = NULL;
+  if(!aot_is_private(so_path, 0)
+      || !(handle = dlopen(so_path, RTLD_NOW | RTLD_LOCAL)))
+    return NULL;
+  abi = dlsym(handle, "ao_abi");
+  lines = dlsym(handle, "ao_lines");
+  if(!abi || !lines || abi[0] != sizeof(ast_result)
+      || abi[1] != sizeof(aot_host) || abi[2] != QTY_BINARY_OPS
+      || abi[3] != QTY_UNARY_OPS) {
+    dlclose(handle);
+    return NULL;
+  }
+  m = calloc(1, sizeof(struct AOT_MODULE_T));
+  m->handle = handle;
+  m->lines = lines;
+  m->qty_lines = qty_lines;
+  m->was_cached = 0;
+  return m;
+}
+
+/**
+ * This function runs a compiled program, printing the result of each
+ * statement as run_program does.
+ * @param    m - The compiled program.
+ * @param prog - The program it was compiled from.
+ * @param   st - The frame (empty or previously bound to the program).
+ * @param   rs - The statistics of the run.
+ * @return N/a
+ */
+void run_aot_module(aot_module * m, program * prog, symbol_table ** st,
+    run_stats * rs) {
+  double start = seconds_now();
+  ast_result result = {0};
+  bind_symbol_table(st[0], prog->layout);
+  for(int i = 0; i < m->qty_lines; i++) {
+    result = m->lines[i](&AOT_HOST, st);
+    ast_print_result(result);
+    free_ast_result(result);
+  }
+  rs->run_time += seconds_now() - start;
+}
+
+/**
+ * This function reads the variable in a slot for compiled code.
+ * @param   st - The frame.
+ * @param slot - The slot.
+ * @param name - The name of the variable.
+ * @param  len - The length of the name.
+ * @return  .\ - The value of the variable.
+ */
+ast_result aot_load(symbol_table ** st, int slot, const char * name,
+    int len) {
+  if(!st[0]->udv[slot]->is_set) {
+    fprintf(stderr, "[EVALUATE_TREE]: Variable `%.*s` not found.\nExiting\n",
+        len, name);
+    exit(1);
+  }
+  return init_ast_result_from_variable(st[0]->udv[slot]);
+}
+
+/**
+ * This function makes a STRING from a literal for compiled code.
+ * @param literal - The bytes of the literal.
+ * @param     len - The number of bytes.
+ * @return     .\ - The STRING.
+ */
+ast_result aot_string(const char * literal, size_t len) {
+  return init_ast_result(literal, len, STRING);
+}
+
+/**
+ * This function unloads a compiled program.
+ * @param    m - The compiled program to be freed.
+ * @return N/a
+ */
+void free_aot_module(aot_module * m) {
+  if(m) {
+    dlclose(m->handle);
+    free(m);
+  }
+}
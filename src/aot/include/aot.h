@@ -0,0 +1,90 @@
+/**
+ * @file   aot.h
+ * @brief  This file contains the function definitions for aot.c
+ * @author Matthew C. Lindeman
+ * @date   October 05, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef AOT_H
+#define AOT_H
+
+#include <stdarg.h>
+#include "../../program/include/program.h"
+
+/** The number of bytes of C the translation of a program starts with room
+ * for */
+#define AOT_INITIAL_TEXT 4096
+
+/**
+ * This structure is what compiled code calls back into: the kernel tables of
+ * ast_result for the cases it does not handle inline (STRINGs, mixed types,
+ * errors) and the access to the frame.  The C a program is translated
+ * to declares the same structure, in the same order.
+ */
+typedef struct AOT_HOST_T {
+  /** Applies a binary operator (ast_result_binary) */
+  ast_result (*binary)(binary_op op, ast_result astr1, ast_result astr2);
+  /** Applies a function (ast_result_unary) */
+  ast_result (*unary)(unary_op op, ast_result astr);
+  /** Reads the variable in a slot (erroring with its name if it is unset) */
+  ast_result (*load)(symbol_table ** st, int slot, const char * name,
+      int len);
+  /** Assigns a value to the variable in a slot */
+  ast_result (*assign)(int slot, ast_result value, symbol_table ** st);
+  /** Makes a STRING from the bytes of a literal */
+  ast_result (*string)(const char * literal, size_t len);
+} aot_host;
+
+/** A statement compiled ahead of time */
+typedef ast_result (*aot_line)(const aot_host * h, symbol_table ** st);
+
+/**
+ * This structure is the C a program is translated to, as it is emitted.
+ */
+typedef struct AOT_BUFFER_T {
+  /** The text */
+  char * text;
+  /** The length of the text */
+  size_t len;
+  /** The number of bytes there is room for */
+  size_t cap;
+  /** The number of temporaries of the statement being emitted */
+  int qty_temps;
+} aot_buffer;
+
+/**
+ * This structure is a program compiled to a shared object and loaded.
+ */
+typedef struct AOT_MODULE_T {
+  /** The handle dlopen gave */
+  void * handle;
+  /** The statements of the program, in order */
+  aot_line * lines;
+  /** The number of statements */
+  int qty_lines;
+  /** Whether the shared object was found in the cache */
+  int was_cached;
+} aot_module;
+
+extern const aot_host AOT_HOST;
+extern const char * AOT_PREAMBLE;
+
+aot_module * aot_compile(program * prog, const char * cache_dir);
+int aot_translate(program * prog, aot_buffer * out);
+int aot_emit_node(aot_buffer * out, ast * abstree);
+void aot_emit_bytes(aot_buffer * out, const char * bytes, size_t len);
+void aot_printf(aot_buffer * out, const char * fmt, ...);
+unsigned long long aot_hash(const char * text, size_t len);
+char * aot_cache_dir(void);
+int aot_make_dirs(const char * path);
+int aot_is_private(const char * path, int is_dir);
+int aot_build(const char * c_path, const char * so_path);
+aot_module * aot_open(const char * so_path, int qty_lines);
+void run_aot_module(aot_module * m, program * prog, symbol_table ** st,
+    run_stats * rs);
+ast_result aot_load(symbol_table ** st, int slot, const char * name, int len);
+ast_result aot_string(const char * literal, size_t len);
+void free_aot_module(aot_module * m);
+
+#endif
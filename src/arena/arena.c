@@ -0,0 +1,135 @@
+/**
+ * @file   arena.c
+ * @brief  This file contains the functions relating to the arena allocator.
+ * @author Matthew C. Lindeman
+ * @date   September 24, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/arena.h"
+
+/**
+ * This function initializes an arena with a single block.
+ * @param N/a
+ * @return a - The new arena.
+ */
+arena * init_arena(void) {
+  arena * a = calloc(1, sizeof(struct ARENA_T));
+  a->head = NULL;
+  a->current = NULL;
+  a->current = add_arena_block(a, ARENA_BLOCK_SIZE);
+  a->head = a->current;
+  a->qty_allocs = 0;
+  a->qty_bytes = 0;
+  a->qty_mallocs = 0;
+  return a;
+}
+
+/**
+ * This function allocates zeroed memory from an arena.
+ * @param    a - The arena to allocate from.
+ * @param size - The number of bytes.
+ * @return  .\ - The memory (valid until the arena is reset).
+ */
+void * arena_alloc(arena * a, size_t size) {
+  void * memory = NULL;
+  size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+  while(a->current->used + size > a->current->size) {
+    if(a->current->next && a->current->next->size >= size)
+      a->current = a->current->next;
+    else
+      a->current = add_arena_block(a, size > ARENA_BLOCK_SIZE
+          ? size : ARENA_BLOCK_SIZE);
+  }
+  memory = a->current->data + a->current->used;
+  a->current->used += size;
+  a->qty_allocs++;
+  a->qty_bytes += size;
+  memset(memory, 0, size);
+  return memory;
+}
+
+/**
+ * This function copies a string into an arena (NUL terminating it).
+ * @param   a - The arena to allocate from.
+ * @param   s - The string to be copied (need not be NUL terminated).
+ * @param len - The length of the string.
+ * @return .\ - The copy.
+ */
+char * arena_strndup(arena * a, const char * s, size_t len) {
+  char * copy = arena_alloc(a, len + 1);
+  memcpy(copy, s, len);
+  return copy;
+}
+
+/**
+ * This function mallocs a new block (header and memory in one allocation) and
+ * links it in after the current block.
+ * @param    a - The arena the block is for.
+ * @param size - The number of usable bytes in the block.
+ * @return   b - The new block.
+ */
+arena_block * add_arena_block(arena * a, size_t size) {
+  // The header is padded so that data keeps the alignment of malloc
+  size_t header = (sizeof(struct ARENA_BLOCK_T) + ARENA_ALIGN - 1)
+    & ~(size_t)(ARENA_ALIGN - 1);
+  arena_block * b = malloc(header + size);
+  b->data = (unsigned char *)b + header;
+  b->size = size;
+  b->used = 0;
+  b->next = a->current ? a->current->next : NULL;
+  if(a->current)
+    a->current->next = b;
+  a->qty_mallocs++;
+  a->total_mallocs++;
+  return b;
+}
+
+/**
+ * This function frees everything allocated from an arena at once (the blocks
+ * are kept for reuse).
+ * @param    a - The arena to be reset.
+ * @return N/a
+ */
+void reset_arena(arena * a) {
+  for(arena_block * b = a->head; b; b = b->next)
+    b->used = 0;
+  a->current = a->head;
+  a->qty_allocs = 0;
+  a->qty_bytes = 0;
+  a->qty_mallocs = 0;
+}
+
+/**
+ * This function is used for debugging arenas.
+ * @param    a - The arena to be debugged.
+ * @return N/a
+ */
+void arena_dump_debug(arena * a) {
+  int qty_blocks = 0;
+  for(arena_block * b = a->head; b; b = b->next)
+    qty_blocks++;
+  printf("Arena\n");
+  printf("Blocks: %d\n", qty_blocks);
+  printf("Allocations Since Reset: %zu (%zu bytes)\n", a->qty_allocs,
+      a->qty_bytes);
+  printf("Mallocs Since Reset: %zu\n", a->qty_mallocs);
+  printf("Total Mallocs: %zu\n", a->total_mallocs);
+  printf("--\n");
+}
+
+/**
+ * This function frees an arena and all of its blocks.
+ * @param    a - The arena to be freed.
+ * @return N/a
+ */
+void free_arena(arena * a) {
+  arena_block * next = NULL;
+  if(a) {
+    for(arena_block * b = a->head; b; b = next) {
+      next = b->next;
+      free(b);
+    }
+    free(a);
+  }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file   arena.h
+ * @brief  This file contains the function definitions for arena.c
+ * @author Matthew C. Lindeman
+ * @date   September 24, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef ARN_H
+#define ARN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** The size of the blocks an arena asks malloc for */
+#define ARENA_BLOCK_SIZE 16384
+/** The alignment of every allocation served by an arena */
+#define ARENA_ALIGN 16
+
+/**
+ * This structure is a single block of memory owned by an arena.
+ */
+typedef struct ARENA_BLOCK_T {
+  /** The next block of the arena */
+  struct ARENA_BLOCK_T * next;
+  /** The number of usable bytes in data */
+  size_t size;
+  /** The number of bytes of data handed out */
+  size_t used;
+  /** The memory of the block */
+  unsigned char * data;
+} arena_block;
+
+/**
+ * This structure is a bump allocator.  Everything allocated from it is freed
+ * at once by reset_arena, which keeps the blocks so that once an arena has
+ * grown to fit a statement it does not call malloc again.
+ */
+typedef struct ARENA_T {
+  /** The first block of the arena */
+  arena_block * head;
+  /** The block allocations are currently served from */
+  arena_block * current;
+  /** The number of allocations served since the last reset */
+  size_t qty_allocs;
+  /** The number of bytes handed out since the last reset */
+  size_t qty_bytes;
+  /** The number of times malloc was called since the last reset */
+  size_t qty_mallocs;
+  /** The number of times malloc was called over the life of the arena */
+  size_t total_mallocs;
+} arena;
+
+arena * init_arena(void);
+void * arena_alloc(arena * a, size_t size);
+char * arena_strndup(arena * a, const char * s, size_t len);
+arena_block * add_arena_block(arena * a, size_t size);
+void reset_arena(arena * a);
+void arena_dump_debug(arena * a);
+void free_arena(arena * a);
+
+#endif
@@ -0,0 +1,573 @@
+/**
+ * @file   closure.c
+ * @brief  This file contains the functions that compile an abstract syntax
+ * tree into closures and the functions the closures run.
+ * @author Matthew C. Lindeman
+ * @date   October 04, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/closure.h"
+
+/**
+ * The functions each operator is compiled to, indexed by token type.  An
+ * operator with no ii/dd function for the types of its operands is compiled
+ * to eval_kernel with its kernel from BINARY_KERNELS bound (if the types are
+ * known) or to eval_binary/eval_unary with its operator bound.
+ */
+const closure_kernels CLOSURE_KERNELS[TOKEN_NEWLINE + 1] = {
+  [TOKEN_PLUS] = {eval_add_ii, eval_add_dd, 0},
+  [TOKEN_MINUS] = {eval_sub_ii, eval_sub_dd, 0},
+  [TOKEN_MULT] = {eval_mul_ii, eval_mul_dd, 0},
+  [TOKEN_DIV] = {eval_div_ii, eval_div_dd, 0},
+  [TOKEN_POWER] = {eval_pow_ii, eval_pow_dd, 0},
+  [TOKEN_EQUALITY] = {eval_eq_ii, eval_eq_dd, 1},
+  [TOKEN_GT_EQ] = {eval_gteq_ii, eval_gteq_dd, 1},
+  [TOKEN_GT] = {eval_gt_ii, eval_gt_dd, 1},
+  [TOKEN_LT_EQ] = {eval_lteq_ii, eval_lteq_dd, 1},
+  [TOKEN_LT] = {eval_lt_ii, eval_lt_dd, 1},
+  [TOKEN_SIN] = {NULL, eval_sin_d, 0},
+  [TOKEN_COS] = {NULL, eval_cos_d, 0},
+  [TOKEN_TAN] = {NULL, eval_tan_d, 0},
+  [TOKEN_ARC_SIN] = {NULL, eval_arc_sin_d, 0},
+  [TOKEN_ARC_COS] = {NULL, eval_arc_cos_d, 0},
+  [TOKEN_ARC_TAN] = {NULL, eval_arc_tan_d, 0},
+  [TOKEN_LOG] = {NULL, eval_log_d, 0},
+};
+
+/**
+ * This function initializes a closure.
+ * @param  a - The arena the closure is allocated from.
+ * @param fn - The function that evaluates the closure.
+ * @return c - The new closure (with no operands and an unknown type).
+ */
+closure * init_closure(arena * a, ast_result (*fn)(closure * c,
+      symbol_table ** st)) {
+  closure * c = arena_alloc(a, sizeof(struct CLOSURE_T));
+  c->fn = fn;
+  c->lhs = NULL;
+  c->rhs = NULL;
+  c->is_typed = 0;
+  return c;
+}
+
+/**
+ * This function compiles a resolved abstract syntax tree into closures.  The
+ * closures are allocated from the same arena as the tree.
+ * @param abstree - The tree to be compiled (resolved with resolve_tree).
+ * @param       a - The arena the closures are allocated from.
+ * @return      c - The root closure.
+ */
+closure * compile_closure(ast * abstree, arena * a) {
+  closure * c = NULL;
+  switch(abstree->value.type) {
+    case TOKEN_VAR:
+      c = init_closure(a, eval_load_slot);
+      c->bound.slot = closure_slot(abstree);
+      // The type checker knows the type of a variable that is set
+      c->type = abstree->type;
+      c->is_typed = abstree->is_typed;
+      return c;
+    case TOKEN_INT:
+      c = init_closure(a, eval_int);
+      c->bound.int_value = abstree->value.value.int_value;
+      c->type = INT;
+      c->is_typed = 1;
+      return c;
+    case TOKEN_DOUBLE:
+      c = init_closure(a, eval_double);
+      c->bound.double_value = abstree->value.value.double_value;
+      c->type = DOUBLE;
+      c->is_typed = 1;
+      return c;
+    case TOKEN_STRING:
+      c = init_closure(a, eval_string);
+      c->bound.string_value = arena_shared_string(a, abstree->value.t_literal,
+          abstree->value.len);
+      c->type = STRING;
+      c->is_typed = 1;
+      return c;
+    case TOKEN_ASSIGN:
+      c = init_closure(a, eval_assign_slot);
+      c->bound.slot = closure_slot(abstree);
+      c->lhs = compile_closure(abstree->children[1], a);
+      c->type = INT;
+      c->is_typed = 1;
+      return c;
+    default:
+      return compile_operator_closure(abstree, a);
+  }
+}
+
+/**
+ * This function compiles an operator (or function) node.  When the operand
+ * types are known the closure is specialised for them and has a known type.
+ * @param abstree - The operator node.
+ * @param       a - The arena the closures are allocated from.
+ * @return      c - The closure of the operator.
+ */
+closure * compile_operator_closure(ast * abstree, arena * a) {
+  const closure_kernels * k = &CLOSURE_KERNELS[abstree->value.type];
+  binary_op op = binary_op_of(abstree->value.type);
+  unary_op fn = unary_op_of(abstree->value.type);
+  ast_result_kernel kernel = NULL;
+  closure * lhs = NULL;
+  closure * rhs = NULL;
+  closure * c = NULL;
+  if(fn != QTY_UNARY_OPS) {
+    lhs = compile_closure(abstree->children[0], a);
+    if(lhs->is_typed && lhs->type == DOUBLE) {
+      c = init_closure(a, k->dd);
+    } else {
+      c = init_closure(a, eval_unary);
+      c->bound.unary = fn;
+    }
+    // A function keeps the type of its operand
+    c->lhs = lhs;
+    c->type = lhs->type;
+    c->is_typed = lhs->is_typed && UNARY_KERNELS[fn][lhs->type];
+    return c;
+  }
+  if(op == QTY_BINARY_OPS) {
+    fprintf(stderr, "[COMPILE_CLOSURE]: Unhandled Token: `%s`\nExiting\n",
+        token_type_to_string(abstree->value.type));
+    exit(1);
+  }
+  lhs = compile_closure(abstree->children[0], a);
+  rhs = compile_closure(abstree->children[1], a);
+  if(lhs->is_typed && rhs->is_typed)
+    kernel = BINARY_KERNELS[op][lhs->type][rhs->type];
+  if(kernel && lhs->type == rhs->type && lhs->type == INT) {
+    c = init_closure(a, k->ii);
+  } else if(kernel && lhs->type == rhs->type && lhs->type == DOUBLE) {
+    c = init_closure(a, k->dd);
+  } else if(kernel) {
+    c = init_closure(a, eval_kernel);
+    c->bound.kernel = kernel;
+  } else {
+    c = init_closure(a, eval_binary);
+    c->bound.binary = op;
+  }
+  c->lhs = lhs;
+  c->rhs = rhs;
+  // A comparison is always an INT
+  c->type = k->is_comparison ? INT
+    : kernel ? binary_result_type(op, lhs->type, rhs->type) : lhs->type;
+  c->is_typed = k->is_comparison || kernel;
+  return c;
+}
+
+/**
+ * This function gives the slot of a resolved TOKEN_VAR/TOKEN_ASSIGN node.
+ * @param abstree - The node.
+ * @return     .\ - The frame slot.
+ */
+int closure_slot(ast * abstree) {
+  if(abstree->slot == -1) {
+    fprintf(stderr, "[CLOSURE_SLOT]: Unresolved variable `%.*s`\nExiting\n",
+        (int)abstree->value.len, abstree->value.t_literal);
+    exit(1);
+  }
+  return abstree->slot;
+}
+
+/**
+ * This function runs a compiled tree.
+ * @param  c - The root closure.
+ * @param st - The stack frame the tree was resolved against.
+ * @return .\ - The value of the tree.
+ */
+ast_result run_closure(closure * c, symbol_table ** st) {
+  return c->fn(c, st);
+}
+
+/**
+ * This function evaluates an INT constant.
+ * @param  c - The closure.
+ * @param st - The stack frame (unused).
+ * @return .\ - The constant.
+ */
+ast_result eval_int(closure * c, symbol_table ** st) {
+  (void)st;
+  return int_ast_result(c->bound.int_value);
+}
+
+/**
+ * This function evaluates a DOUBLE constant.
+ * @param  c - The closure.
+ * @param st - The stack frame (unused).
+ * @return .\ - The constant.
+ */
+ast_result eval_double(closure * c, symbol_table ** st) {
+  (void)st;
+  return double_ast_result(c->bound.double_value);
+}
+
+/**
+ * This function evaluates a STRING constant.  The string lives in the arena
+ * so the result does not take a reference to it.
+ * @param  c - The closure.
+ * @param st - The stack frame (unused).
+ * @return .\ - The constant.
+ */
+ast_result eval_string(closure * c, symbol_table ** st) {
+  (void)st;
+  return string_ast_result(c->bound.string_value);
+}
+
+/**
+ * This function reads the variable in the bound slot.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The value of the variable.
+ */
+ast_result eval_load_slot(closure * c, symbol_table ** st) {
+  variable * var = st[0]->udv[c->bound.slot];
+  if(!var->is_set) {
+    fprintf(stderr, "[EVAL_LOAD_SLOT]: Variable `%s` not found.\nExiting\n",
+        var->name->name);
+    exit(1);
+  }
+  return init_ast_result_from_variable(var);
+}
+
+/**
+ * This function assigns the value of the operand to the bound slot.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1::Assignment Worked
+ */
+ast_result eval_assign_slot(closure * c, symbol_table ** st) {
+  return ast_result_assign_slot(c->bound.slot, c->lhs->fn(c->lhs, st), st);
+}
+
+/**
+ * This function applies the bound operator to two operands of types that
+ * were not known at compile time (the kernel table checks them).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The result of the operation.
+ */
+ast_result eval_binary(closure * c, symbol_table ** st) {
+  ast_result lhs = c->lhs->fn(c->lhs, st);
+  return ast_result_binary(c->bound.binary, lhs, c->rhs->fn(c->rhs, st));
+}
+
+/**
+ * This function applies the bound kernel to two operands whose types were
+ * known at compile time but have no ii/dd function (e.g. INT + DOUBLE).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The result of the operation.
+ */
+ast_result eval_kernel(closure * c, symbol_table ** st) {
+  ast_result lhs = c->lhs->fn(c->lhs, st);
+  return c->bound.kernel(lhs, c->rhs->fn(c->rhs, st));
+}
+
+/**
+ * This function applies the bound function to an operand of a type that was
+ * not known at compile time (the kernel table checks it).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The result of the function.
+ */
+ast_result eval_unary(closure * c, symbol_table ** st) {
+  return ast_result_unary(c->bound.unary, c->lhs->fn(c->lhs, st));
+}
+
+/**
+ * This function adds two INT operands.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The sum.
+ */
+ast_result eval_add_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  return int_ast_result(int_add(lhs, c->rhs->fn(c->rhs, st).value.int_value));
+}
+
+/**
+ * This function adds two DOUBLE operands.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The sum.
+ */
+ast_result eval_add_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return double_ast_result(lhs + c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function subtracts two INT operands.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The difference.
+ */
+ast_result eval_sub_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  return int_ast_result(int_sub(lhs, c->rhs->fn(c->rhs, st).value.int_value));
+}
+
+/**
+ * This function subtracts two DOUBLE operands.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The difference.
+ */
+ast_result eval_sub_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return double_ast_result(lhs - c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function multiplies two INT operands.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The product.
+ */
+ast_result eval_mul_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  return int_ast_result(int_mul(lhs, c->rhs->fn(c->rhs, st).value.int_value));
+}
+
+/**
+ * This function multiplies two DOUBLE operands.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The product.
+ */
+ast_result eval_mul_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return double_ast_result(lhs * c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function divides two INT operands.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The quotient.
+ */
+ast_result eval_div_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  long long rhs = c->rhs->fn(c->rhs, st).value.int_value;
+  if(rhs == 0) {
+    fprintf(stderr, "[AST_RESULT_DIV]: Integer Division by Zero\nExiting\n");
+    exit(1);
+  }
+  return int_ast_result(int_div(lhs, rhs));
+}
+
+/**
+ * This function divides two DOUBLE operands.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The quotient.
+ */
+ast_result eval_div_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return double_ast_result(lhs / c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function raises an INT operand to an INT power.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The power.
+ */
+ast_result eval_pow_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  long long rhs = c->rhs->fn(c->rhs, st).value.int_value;
+  return int_ast_result(double_to_int(pow(lhs, rhs)));
+}
+
+/**
+ * This function raises a DOUBLE operand to a DOUBLE power.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The power.
+ */
+ast_result eval_pow_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return double_ast_result(pow(lhs, c->rhs->fn(c->rhs, st).value.double_value));
+}
+
+/**
+ * This function compares two INT operands (==).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_eq_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  return int_ast_result(lhs == c->rhs->fn(c->rhs, st).value.int_value);
+}
+
+/**
+ * This function compares two DOUBLE operands (==).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_eq_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return int_ast_result(lhs == c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function compares two INT operands (>=).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_gteq_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  return int_ast_result(lhs >= c->rhs->fn(c->rhs, st).value.int_value);
+}
+
+/**
+ * This function compares two DOUBLE operands (>=).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_gteq_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return int_ast_result(lhs >= c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function compares two INT operands (>).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_gt_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  return int_ast_result(lhs > c->rhs->fn(c->rhs, st).value.int_value);
+}
+
+/**
+ * This function compares two DOUBLE operands (>).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_gt_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return int_ast_result(lhs > c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function compares two INT operands (<=).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_lteq_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  return int_ast_result(lhs <= c->rhs->fn(c->rhs, st).value.int_value);
+}
+
+/**
+ * This function compares two DOUBLE operands (<=).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_lteq_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return int_ast_result(lhs <= c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function compares two INT operands (<).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_lt_ii(closure * c, symbol_table ** st) {
+  long long lhs = c->lhs->fn(c->lhs, st).value.int_value;
+  return int_ast_result(lhs < c->rhs->fn(c->rhs, st).value.int_value);
+}
+
+/**
+ * This function compares two DOUBLE operands (<).
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - 1 if the comparison holds, 0 otherwise.
+ */
+ast_result eval_lt_dd(closure * c, symbol_table ** st) {
+  double lhs = c->lhs->fn(c->lhs, st).value.double_value;
+  return int_ast_result(lhs < c->rhs->fn(c->rhs, st).value.double_value);
+}
+
+/**
+ * This function takes the sin of a DOUBLE operand.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The sin of the operand.
+ */
+ast_result eval_sin_d(closure * c, symbol_table ** st) {
+  return double_ast_result(sin(c->lhs->fn(c->lhs, st).value.double_value));
+}
+
+/**
+ * This function takes the cos of a DOUBLE operand.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The cos of the operand.
+ */
+ast_result eval_cos_d(closure * c, symbol_table ** st) {
+  return double_ast_result(cos(c->lhs->fn(c->lhs, st).value.double_value));
+}
+
+/**
+ * This function takes the tan of a DOUBLE operand.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The tan of the operand.
+ */
+ast_result eval_tan_d(closure * c, symbol_table ** st) {
+  return double_ast_result(tan(c->lhs->fn(c->lhs, st).value.double_value));
+}
+
+/**
+ * This function takes the asin of a DOUBLE operand.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The asin of the operand.
+ */
+ast_result eval_arc_sin_d(closure * c, symbol_table ** st) {
+  return double_ast_result(asin(c->lhs->fn(c->lhs, st).value.double_value));
+}
+
+/**
+ * This function takes the acos of a DOUBLE operand.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The acos of the operand.
+ */
+ast_result eval_arc_cos_d(closure * c, symbol_table ** st) {
+  return double_ast_result(acos(c->lhs->fn(c->lhs, st).value.double_value));
+}
+
+/**
+ * This function takes the atan of a DOUBLE operand.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The atan of the operand.
+ */
+ast_result eval_arc_tan_d(closure * c, symbol_table ** st) {
+  return double_ast_result(atan(c->lhs->fn(c->lhs, st).value.double_value));
+}
+
+/**
+ * This function takes the log of a DOUBLE operand.
+ * @param  c - The closure.
+ * @param st - The stack frame.
+ * @return .\ - The log of the operand.
+ */
+ast_result eval_log_d(closure * c, symbol_table ** st) {
+  return double_ast_result(log(c->lhs->fn(c->lhs, st).value.double_value));
+}
@@ -0,0 +1,109 @@
+/**
+ * @file   closure.h
+ * @brief  This file contains the function definitions for closure.c
+ * @author Matthew C. Lindeman
+ * @date   October 04, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef CLS_H
+#define CLS_H
+
+#include <math.h>
+#include "../../parser/include/abstract_syntax_tree.h"
+
+/**
+ * This structure is a node of a tree compiled into closures.  Each node is a
+ * function with its operands and constants bound when it is compiled, so
+ * running it does not look at token types.  When the types of the operands
+ * are known before running, the function is one specialised for them (e.g.
+ * eval_add_dd) and does not check them either.
+ */
+typedef struct CLOSURE_T {
+  /** The function that evaluates the closure */
+  ast_result (*fn)(struct CLOSURE_T * c, symbol_table ** st);
+  /** The first operand (or the value of an assignment) */
+  struct CLOSURE_T * lhs;
+  /** The second operand */
+  struct CLOSURE_T * rhs;
+  /** What is bound at compile time (which member is live depends on fn) */
+  union {
+    /** The value of an INT constant */
+    long long int_value;
+    /** The value of a DOUBLE constant */
+    double double_value;
+    /** The value of a STRING constant (in the arena) */
+    shared_string * string_value;
+    /** The frame slot of a variable or of the target of an assignment */
+    int slot;
+    /** The operator of a binary closure whose operand types are not known */
+    binary_op binary;
+    /** The function of a unary closure whose operand type is not known */
+    unary_op unary;
+    /** The kernel of a binary closure whose operand types are known */
+    ast_result_kernel kernel;
+  } bound;
+  /** The type of the value of the closure (only if is_typed) */
+  var_type type;
+  /** Whether the type of the value is known before running */
+  int is_typed;
+} closure;
+
+/**
+ * This structure holds the functions an operator is compiled to, by the
+ * types of its operands.
+ */
+typedef struct CLOSURE_KERNELS_T {
+  /** The operation on two INT operands */
+  ast_result (*ii)(closure * c, symbol_table ** st);
+  /** The operation on two DOUBLE operands (or one for a function) */
+  ast_result (*dd)(closure * c, symbol_table ** st);
+  /** Whether the operator always has an INT value (i.e. a comparison) */
+  int is_comparison;
+} closure_kernels;
+
+extern const closure_kernels CLOSURE_KERNELS[TOKEN_NEWLINE + 1];
+
+closure * init_closure(arena * a, ast_result (*fn)(closure * c,
+      symbol_table ** st));
+closure * compile_closure(ast * abstree, arena * a);
+closure * compile_operator_closure(ast * abstree, arena * a);
+int closure_slot(ast * abstree);
+ast_result run_closure(closure * c, symbol_table ** st);
+ast_result eval_int(closure * c, symbol_table ** st);
+ast_result eval_double(closure * c, symbol_table ** st);
+ast_result eval_string(closure * c, symbol_table ** st);
+ast_result eval_load_slot(closure * c, symbol_table ** st);
+ast_result eval_assign_slot(closure * c, symbol_table ** st);
+ast_result eval_binary(closure * c, symbol_table ** st);
+ast_result eval_kernel(closure * c, symbol_table ** st);
+ast_result eval_unary(closure * c, symbol_table ** st);
+ast_result eval_add_ii(closure * c, symbol_table ** st);
+ast_result eval_add_dd(closure * c, symbol_table ** st);
+ast_result eval_sub_ii(closure * c, symbol_table ** st);
+ast_result eval_sub_dd(closure * c, symbol_table ** st);
+ast_result eval_mul_ii(closure * c, symbol_table ** st);
+ast_result eval_mul_dd(closure * c, symbol_table ** st);
+ast_result eval_div_ii(closure * c, symbol_table ** st);
+ast_result eval_div_dd(closure * c, symbol_table ** st);
+ast_result eval_pow_ii(closure * c, symbol_table ** st);
+ast_result eval_pow_dd(closure * c, symbol_table ** st);
+ast_result eval_eq_ii(closure * c, symbol_table ** st);
+ast_result eval_eq_dd(closure * c, symbol_table ** st);
+ast_result eval_gteq_ii(closure * c, symbol_table ** st);
+ast_result eval_gteq_dd(closure * c, symbol_table ** st);
+ast_result eval_gt_ii(closure * c, symbol_table ** st);
+ast_result eval_gt_dd(closure * c, symbol_table ** st);
+ast_result eval_lteq_ii(closure * c, symbol_table ** st);
+ast_result eval_lteq_dd(closure * c, symbol_table ** st);
+ast_result eval_lt_ii(closure * c, symbol_table ** st);
+ast_result eval_lt_dd(closure * c, symbol_table ** st);
+ast_result eval_sin_d(closure * c, symbol_table ** st);
+ast_result eval_cos_d(closure * c, symbol_table ** st);
+ast_result eval_tan_d(closure * c, symbol_table ** st);
+ast_result eval_arc_sin_d(closure * c, symbol_table ** st);
+ast_result eval_arc_cos_d(closure * c, symbol_table ** st);
+ast_result eval_arc_tan_d(closure * c, symbol_table ** st);
+ast_result eval_log_d(closure * c, symbol_table ** st);
+
+#endif
@@ -7,75 +7,92 @@
  * @bug    None known
  * @todo   Nothing
  */
+#define _POSIX_C_SOURCE 200809L
 #include "include/console.h"
 
 /**
  * This function starts the REPL and will not end until the user sends the
- * command "exit".
- * @param  N/a
+ * command "exit".  Every line is a program of one statement, the layout of
+ * the program is kept between lines and holds the variables of the session.
+ * Lines are read whole, whatever their length.
+ * @param opts - The command line options.
  * @return N/a
  */
-void repl(void) {
-  char buf[MAX_TOK_LEN];
+void repl(options * opts) {
+  char * line = NULL;
+  size_t cap_line = 0;
+  ssize_t len = 0;
   lexer * lex = NULL;
-  token_stack * ts = NULL;
-  token_stack * rev = NULL;
-  ast * abstree = NULL;
-  ast_result * astr = NULL;
-  symbol_table * st = init_symbol_table();
+  token_buffer * tb = init_token_buffer();
+  program * prog = init_program();
+  run_stats rs = {0};
+  vm * v = init_vm();
   print_logo();
   print_information();
   while(1) {
     printf("|> ");
-    fgets(buf, MAX_TOK_LEN, stdin);
-    if(!strncmp("exit\n", buf, MAX_TOK_LEN))
+    len = getline(&line, &cap_line, stdin);
+    if(len == -1 || (len >= 4 && !strncmp("exit", line, 4)
+          && (len == 4 || line[4] == '\n')))
       break;
-    lex = init_lexer(buf);
-    ts = lex_source(lex);
-    rev = reverse_stack(&ts);
-    abstree = parse_expression(&rev, &st);
-    astr = evaluate_tree(abstree, &st);
-    ast_print_result(astr);
-    // ast_result_dump_debug(astr);
-    free_ast(abstree);
-    free_ast_result(astr);
-    while(rev)
-      rev = pop_token(rev);
-    while(ts)
-      ts = pop_token(ts);
+    lex = init_lexer(line, len);
+    lex_source(lex, tb);
+    if(CURRENT_TOKEN(tb).type != TOKEN_NEWLINE) {
+      parse_statement(prog, tb, rs.qty_lines + 1, opts, &rs);
+      run_program(prog, v, &prog->layout, &rs);
+      reset_program(prog);
+    }
     free_lexer(lex);
   }
-  free_symbol_table(st);
+  if(opts->stats)
+    run_stats_dump(&rs, prog);
+  free(line);
+  free_token_buffer(tb);
+  free_program(prog);
+  free_vm(v);
 }
 
-void interpret(char * file_name) {
-  FILE * fp = fopen(file_name, "r");
-  char buf[MAX_TOK_LEN];
-  lexer * lex = NULL;
-  token_stack * ts = NULL;
-  token_stack * rev = NULL;
-  ast * abstree = NULL;
-  ast_result * astr = NULL;
-  symbol_table * st = init_symbol_table();
-  while(1) {
-    fgets(buf, MAX_TOK_LEN, fp);
-    if(!strncmp("exit\n", buf, MAX_TOK_LEN))
-      break;
-    lex = init_lexer(buf);
-    ts = lex_source(lex);
-    rev = reverse_stack(&ts);
-    abstree = parse_expression(&rev, &st);
-    astr = evaluate_tree(abstree, &st);
-    ast_print_result(astr);
-    // ast_result_dump_debug(astr);
-    free_ast(abstree);
-    free_ast_result(astr);
-    while(rev)
-      rev = pop_token(rev);
-    while(ts)
-      ts = pop_token(ts);
-    free_lexer(lex);
+/**
+ * This function runs the program in a source file.  The whole file is loaded
+ * at once, parsed and compiled up to the line "exit" or the end of the file,
+ * then run (opts->repeat times, each with fresh variables).  With --aot it is
+ * run as native code compiled from it, if that can be done.
+ * @param opts - The command line options (holding the source file name).
+ * @return N/a
+ */
+void interpret(options * opts) {
+  source_file * sf = load_source_file(opts->file_name);
+  program * prog = init_program();
+  run_stats rs = {0};
+  vm * v = init_vm();
+  symbol_table * st = NULL;
+  aot_module * m = NULL;
+  char * cache_dir = NULL;
+  double start = 0;
+  parse_program(prog, sf->src, sf->len, opts, &rs);
+  if(opts->aot) {
+    start = seconds_now();
+    cache_dir = aot_cache_dir();
+    if(cache_dir)
+      m = aot_compile(prog, cache_dir);
+    else
+      fprintf(stderr, "[INTERPRET]: No cache directory for --aot (set "
+          "$AO_CACHE_DIR, $XDG_CACHE_HOME or $HOME), interpreting instead\n");
+    free(cache_dir);
+    rs.front_end_time += seconds_now() - start;
+  }
+  for(int i = 0; i < opts->repeat; i++) {
+    st = init_symbol_table();
+    if(m)
+      run_aot_module(m, prog, &st, &rs);
+    else
+      run_program(prog, v, &st, &rs);
+    free_symbol_table(st);
   }
-  free_symbol_table(st);
-  fclose(fp);
+  if(opts->stats)
+    run_stats_dump(&rs, prog);
+  free_aot_module(m);
+  free_program(prog);
+  free_vm(v);
+  free_source_file(sf);
 }
@@ -10,13 +10,17 @@
 #define SOL_H
 
 #include "menu.h"
+#include "options.h"
+#include "source_file.h"
 #include "../../lexer/include/lexer.h"
-#include "../../main/include/constants.h"
 #include "../../parser/include/abstract_syntax_tree.h"
 #include "../../parser/include/parser.h"
+#include "../../program/include/program.h"
+#include "../../aot/include/aot.h"
 #include "../../symbol_table/include/symbol_table.h"
+#include "../../vm/include/vm.h"
 
-void repl(void);
-void interpret(char * file_name);
+void repl(options * opts);
+void interpret(options * opts);
 
 #endif
@@ -0,0 +1,54 @@
+/**
+ * @file   options.h
+ * @brief  This file contains the function definitions for options.c
+ * @author Matthew C. Lindeman
+ * @date   September 26, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef OPTS_H
+#define OPTS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The engines a program can be run with.
+ */
+typedef enum {
+  /** Compile each statement to bytecode and run it on the vm (the default) */
+  ENGINE_VM,
+  /** Walk the tree of each statement (evaluate_tree) */
+  ENGINE_TREE,
+  /** Compile each statement to closures and call them */
+  ENGINE_CLOSURE
+} engine;
+
+/**
+ * This structure holds the command line options of the interpreter.
+ */
+typedef struct OPTIONS_T {
+  /** The source file to be run (NULL for the REPL) */
+  char * file_name;
+  /** Whether trees are simplified before they are run (--no-simplify) */
+  int simplify;
+  /** Whether statistics are printed to stderr at exit (--stats) */
+  int stats;
+  /** The number of times a source file is run (--repeat=N) */
+  int repeat;
+  /** The engine statements are run with (--engine=tree|vm|closure) */
+  engine eng;
+  /** Whether numeric statements are compiled to native code (off with
+   * --no-jit) */
+  int jit;
+  /** Whether the file is compiled to a shared object with the system C
+   * compiler and run natively (--aot) */
+  int aot;
+} options;
+
+options * init_options(int argc, char * argv[]);
+void print_usage(void);
+void free_options(options * opts);
+
+#endif
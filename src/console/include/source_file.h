@@ -0,0 +1,36 @@
+/**
+ * @file   source_file.h
+ * @brief  This file contains the function definitions for source_file.c
+ * @author Matthew C. Lindeman
+ * @date   September 10, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef SRCF_H
+#define SRCF_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * This structure holds the whole of a source file in memory.  The source is
+ * memory mapped when possible and read in one pass otherwise, it is not NUL
+ * terminated.
+ */
+typedef struct SOURCE_FILE_T {
+  /** The contents of the file */
+  char * src;
+  /** The length of the contents */
+  size_t len;
+  /** Whether src is a mapping (1) or a heap buffer (0) */
+  int is_mapped;
+} source_file;
+
+source_file * load_source_file(char * file_name);
+void free_source_file(source_file * sf);
+
+#endif
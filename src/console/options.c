@@ -0,0 +1,88 @@
+/**
+ * @file   options.c
+ * @brief  This file contains the functions relating to the command line
+ * options of the interpreter.
+ * @author Matthew C. Lindeman
+ * @date   September 26, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/options.h"
+
+/**
+ * This function parses the command line.  Anything that does not start with
+ * "--" is taken to be the source file.
+ * @param argc - The number of arguments.
+ * @param argv - The arguments.
+ * @return opts - The options.
+ */
+options * init_options(int argc, char * argv[]) {
+  options * opts = calloc(1, sizeof(struct OPTIONS_T));
+  opts->file_name = NULL;
+  opts->simplify = 1;
+  opts->stats = 0;
+  opts->repeat = 1;
+  opts->eng = ENGINE_VM;
+  opts->jit = 1;
+  opts->aot = 0;
+  for(int i = 1; i < argc; i++) {
+    if(!strcmp(argv[i], "--no-simplify")) {
+      opts->simplify = 0;
+    } else if(!strcmp(argv[i], "--stats")) {
+      opts->stats = 1;
+    } else if(!strncmp(argv[i], "--repeat=", 9)) {
+      opts->repeat = atoi(argv[i] + 9);
+      if(opts->repeat < 1) {
+        fprintf(stderr, "[INIT_OPTIONS]: Bad repeat count `%s`\nExiting\n",
+            argv[i] + 9);
+        exit(1);
+      }
+    } else if(!strcmp(argv[i], "--engine=vm")) {
+      opts->eng = ENGINE_VM;
+    } else if(!strcmp(argv[i], "--engine=tree")) {
+      opts->eng = ENGINE_TREE;
+    } else if(!strcmp(argv[i], "--engine=closure")) {
+      opts->eng = ENGINE_CLOSURE;
+    } else if(!strcmp(argv[i], "--no-jit")) {
+      opts->jit = 0;
+    } else if(!strcmp(argv[i], "--aot")) {
+      opts->aot = 1;
+    } else if(!strncmp(argv[i], "--", 2) || opts->file_name) {
+      fprintf(stderr, "[INIT_OPTIONS]: Unknown argument `%s`\n", argv[i]);
+      print_usage();
+      fprintf(stderr, "Exiting\n");
+      exit(1);
+    } else {
+      opts->file_name = argv[i];
+    }
+  }
+  return opts;
+}
+
+/**
+ * This function prints the command line usage to stderr.
+ * @param  N/a
+ * @return N/a
+ */
+void print_usage(void) {
+  fprintf(stderr, "Usage: main [options] [file]\n");
+  fprintf(stderr, "  --no-simplify  do not fold constants before running\n");
+  fprintf(stderr, "  --stats        print statistics to stderr at exit\n");
+  fprintf(stderr, "  --repeat=N     run the file N times (parsing it once)\n");
+  fprintf(stderr, "  --engine=E     run statements with E: vm (default), tree "
+      "or closure\n");
+  fprintf(stderr, "  --no-jit       do not compile numeric lines to native "
+      "code\n");
+  fprintf(stderr, "  --aot          compile the file to C and run it natively "
+      "(cached)\n");
+}
+
+/**
+ * This function frees the options.
+ * @param opts - The options to be freed.
+ * @return N/a
+ */
+void free_options(options * opts) {
+  if(opts)
+    free(opts);
+}
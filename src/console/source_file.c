@@ -0,0 +1,71 @@
+/**
+ * @file   source_file.c
+ * @brief  This file contains the functions that load a source file into
+ * memory in one go.
+ * @author Matthew C. Lindeman
+ * @date   September 10, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "include/source_file.h"
+
+/**
+ * This function loads the whole of a file into memory.
+ * @param file_name - The name of the file to be loaded.
+ * @return       sf - The loaded file.
+ */
+source_file * load_source_file(char * file_name) {
+  struct stat sb;
+  ssize_t qty_read = 0;
+  int fd = open(file_name, O_RDONLY);
+  if(fd == -1 || fstat(fd, &sb) == -1) {
+    fprintf(stderr, "[LOAD_SOURCE_FILE]: Could not open `%s`\nExiting\n",
+        file_name);
+    exit(1);
+  }
+  source_file * sf = calloc(1, sizeof(struct SOURCE_FILE_T));
+  sf->len = 0;
+  sf->src = NULL;
+  sf->is_mapped = 0;
+  if(S_ISREG(sb.st_mode) && sb.st_size > 0) {
+    sf->src = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(sf->src != MAP_FAILED) {
+      sf->len = sb.st_size;
+      sf->is_mapped = 1;
+      posix_madvise(sf->src, sf->len, POSIX_MADV_SEQUENTIAL);
+      close(fd);
+      return sf;
+    }
+    sf->src = NULL;
+  }
+  // Not mappable (i.e. a pipe), fall back to reading it all in one pass
+  size_t cap = sb.st_size > 0 ? (size_t)sb.st_size : BUFSIZ;
+  sf->src = malloc(cap);
+  while((qty_read = read(fd, sf->src + sf->len, cap - sf->len)) > 0) {
+    sf->len += qty_read;
+    if(sf->len == cap) {
+      cap *= 2;
+      sf->src = realloc(sf->src, cap);
+    }
+  }
+  close(fd);
+  return sf;
+}
+
+/**
+ * This function frees a source_file.
+ * @param   sf - The source_file to be freed.
+ * @return N/a
+ */
+void free_source_file(source_file * sf) {
+  if(sf) {
+    if(sf->src) {
+      if(sf->is_mapped)
+        munmap(sf->src, sf->len);
+      else
+        free(sf->src);
+    }
+    free(sf);
+  }
+}
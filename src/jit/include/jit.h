@@ -0,0 +1,111 @@
+/**
+ * @file   jit.h
+ * @brief  This file contains the function definitions for jit.c
+ * @author Matthew C. Lindeman
+ * @date   October 05, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef JIT_H
+#define JIT_H
+
+#include <stddef.h>
+#include <math.h>
+#include "../../parser/include/abstract_syntax_tree.h"
+
+/** The size of a region of executable memory (a multiple of the page size) */
+#define JIT_REGION_SIZE 65536
+/** The number of bytes of code a function starts with room for */
+#define JIT_INITIAL_CODE 256
+
+/**
+ * The signature of compiled code.  It reads variables straight out of the
+ * frame and writes the long long/double value to out.
+ * @param udv - The variables of the frame.
+ * @param out - Where the value is written.
+ * @return .\ - 0 if the value was computed, 1 if the interpreter has to run
+ *              the statement instead (i.e. an INT division by zero).
+ */
+typedef int (*jit_entry)(variable ** udv, void * out);
+
+/** The type of the address of a C function called by compiled code */
+typedef void (*jit_callee)(void);
+
+/**
+ * This structure is a region of executable memory that compiled functions are
+ * appended to.  It is only ever writable while a function is copied in.
+ */
+typedef struct JIT_REGION_T {
+  /** The memory of the region (mapped) */
+  unsigned char * code;
+  /** The number of bytes in use */
+  size_t used;
+  /** The size of the region */
+  size_t size;
+  /** The next region */
+  struct JIT_REGION_T * next;
+} jit_region;
+
+/**
+ * This structure is the native code compiler of a program.  It compiles a
+ * statement made only of INT/DOUBLE arithmetic, ^ and the math functions to
+ * SSE2 code the first time it is run, using the types the variables have
+ * then.  The code only runs while the variables still have those types.
+ */
+typedef struct JIT_T {
+  /** The regions of executable memory (the newest first) */
+  jit_region * regions;
+  /** The number of functions compiled */
+  int qty_functions;
+} jit;
+
+/**
+ * This structure is the code being emitted for a function.
+ */
+typedef struct JIT_BUFFER_T {
+  /** The bytes of the code */
+  unsigned char * bytes;
+  /** The number of bytes emitted */
+  size_t len;
+  /** The number of bytes there is room for */
+  size_t cap;
+  /** The number of 8 byte values pushed on the machine stack */
+  int depth;
+} jit_buffer;
+
+/**
+ * This structure is a compiled statement.
+ */
+typedef struct JIT_FUNCTION_T {
+  /** The native code */
+  jit_entry entry;
+  /** The slots of the variables the code reads */
+  int * guard_slots;
+  /** The types the code expects those variables to have */
+  var_type * guard_types;
+  /** The number of variables the code reads */
+  int qty_guards;
+  /** The type of the value of the code */
+  var_type type;
+  /** The slot the value is assigned to (-1 if it is the value of the
+   * statement) */
+  int assign_slot;
+} jit_function;
+
+jit * init_jit(void);
+jit_function * jit_compile(jit * j, ast * abstree, symbol_table * st,
+    arena * a);
+void jit_collect_guards(jit_function * jf, ast * abstree, symbol_table * st);
+int jit_type_of(ast * abstree, symbol_table * st, var_type * type);
+var_type jit_emit_node(jit_buffer * jb, ast * abstree, symbol_table * st);
+void jit_emit_call(jit_buffer * jb, jit_callee fn);
+void jit_emit(jit_buffer * jb, const char * bytes, size_t n);
+void jit_emit_u32(jit_buffer * jb, unsigned int value);
+void jit_emit_u64(jit_buffer * jb, unsigned long long value);
+jit_callee jit_function_for(token_type type);
+jit_entry jit_install(jit * j, jit_buffer * jb);
+int jit_run(jit_function * jf, symbol_table ** st, ast_result * result);
+void reset_jit(jit * j);
+void free_jit(jit * j);
+
+#endif
@@ -0,0 +1,421 @@
+/**
+ * @file   jit.c
+ * @brief  This file contains the functions of the native code compiler.  The
+ * code is x86-64 (System V) with SSE2 for doubles: a value is computed into
+ * rax (INT) or xmm0 (DOUBLE), the left operand of a binary operator waits on
+ * the machine stack while the right one is computed, and the math functions
+ * are called in libm.  rbx holds the variables of the frame, r12 the address
+ * of the result and r13 the stack pointer to return with.  On any other
+ * architecture nothing is compiled.
+ * @author Matthew C. Lindeman
+ * @date   October 05, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#define _DEFAULT_SOURCE
+#include <sys/mman.h>
+#include "include/jit.h"
+
+/**
+ * This function initializes a jit with no executable memory.
+ * @param N/a
+ * @return j - The new jit.
+ */
+jit * init_jit(void) {
+  jit * j = calloc(1, sizeof(struct JIT_T));
+  j->regions = NULL;
+  j->qty_functions = 0;
+  return j;
+}
+
+/**
+ * This function compiles a resolved statement to native code.  The types of
+ * the variables are taken from the frame it is about to run in.
+ * @param       j - The jit.
+ * @param abstree - The tree of the statement (resolved with resolve_tree).
+ * @param      st - The frame the statement is about to run in.
+ * @param       a - The arena the function is allocated from.
+ * @return     jf - The compiled function, NULL if the statement is not
+ *                  purely numeric (or can not be compiled here).
+ */
+jit_function * jit_compile(jit * j, ast * abstree, symbol_table * st,
+    arena * a) {
+#if defined(__x86_64__)
+  jit_function * jf = NULL;
+  jit_buffer jb = {0};
+  ast * expression = abstree;
+  int qty_nodes = 0;
+  var_type type = INT;
+  if(abstree->value.type == TOKEN_ASSIGN)
+    expression = abstree->children[1];
+  if((abstree->value.type == TOKEN_ASSIGN && abstree->slot == -1)
+      || !jit_type_of(expression, st, &type))
+    return NULL;
+  qty_nodes = ast_count_nodes(expression);
+  jf = arena_alloc(a, sizeof(struct JIT_FUNCTION_T));
+  jf->guard_slots = arena_alloc(a, qty_nodes * sizeof(int));
+  jf->guard_types = arena_alloc(a, qty_nodes * sizeof(var_type));
+  jf->qty_guards = 0;
+  jf->type = type;
+  jf->assign_slot = abstree->value.type == TOKEN_ASSIGN ? abstree->slot : -1;
+  jit_collect_guards(jf, expression, st);
+  jb.cap = JIT_INITIAL_CODE;
+  jb.bytes = malloc(jb.cap);
+  // push rbx; push r12; push r13; mov rbx, rdi; mov r12, rsi; mov r13, rsp
+  jit_emit(&jb, "\x53\x41\x54\x41\x55\x48\x89\xFB\x49\x89\xF4\x49\x89\xE5",
+      14);
+  if(jit_emit_node(&jb, expression, st) == DOUBLE)
+    jit_emit(&jb, "\xF2\x41\x0F\x11\x04\x24", 6); // movsd [r12], xmm0
+  else
+    jit_emit(&jb, "\x49\x89\x04\x24", 4);         // mov [r12], rax
+  // xor eax, eax; pop r13; pop r12; pop rbx; ret
+  jit_emit(&jb, "\x31\xC0\x41\x5D\x41\x5C\x5B\xC3", 8);
+  jf->entry = jit_install(j, &jb);
+  free(jb.bytes);
+  if(!jf->entry)
+    return NULL;
+  j->qty_functions++;
+  return jf;
+#else
+  (void)j;
+  (void)abstree;
+  (void)st;
+  (void)a;
+  return NULL;
+#endif
+}
+
+/**
+ * This function records the slot and type of every variable a tree reads
+ * (once each) as the guards of a compiled function.
+ * @param      jf - The compiled function.
+ * @param abstree - The tree.
+ * @param      st - The frame the types are taken from.
+ * @return    N/a
+ */
+void jit_collect_guards(jit_function * jf, ast * abstree, symbol_table * st) {
+  if(abstree->value.type == TOKEN_VAR) {
+    for(int i = 0; i < jf->qty_guards; i++)
+      if(jf->guard_slots[i] == abstree->slot)
+        return;
+    jf->guard_slots[jf->qty_guards] = abstree->slot;
+    jf->guard_types[jf->qty_guards++] = st->udv[abstree->slot]->type;
+  }
+  for(int i = 0; i < abstree->no_children; i++)
+    jit_collect_guards(jf, abstree->children[i], st);
+}
+
+/**
+ * This function determines if a tree can be compiled (it is made of INT and
+ * DOUBLE values of a single type, arithmetic, ^ and the math functions) and
+ * the type of its value with the variables of a frame.
+ * @param abstree - The tree.
+ * @param      st - The frame.
+ * @param    type - Set to the type of the value of the tree.
+ * @return     .\ - 1 if the tree can be compiled, 0 otherwise.
+ */
+int jit_type_of(ast * abstree, symbol_table * st, var_type * type) {
+  var_type rhs = INT;
+  variable * var = NULL;
+  switch(abstree->value.type) {
+    case TOKEN_INT:
+      *type = INT;
+      return 1;
+    case TOKEN_DOUBLE:
+      *type = DOUBLE;
+      return 1;
+    case TOKEN_VAR:
+      if(abstree->slot == -1 || abstree->slot >= st->qty_udv)
+        return 0;
+      var = st->udv[abstree->slot];
+      *type = var->type;
+      return var->is_set && var->type != STRING;
+    case TOKEN_PLUS:
+    case TOKEN_MINUS:
+    case TOKEN_MULT:
+    case TOKEN_DIV:
+    case TOKEN_POWER:
+      return jit_type_of(abstree->children[0], st, type)
+        && jit_type_of(abstree->children[1], st, &rhs) && *type == rhs;
+    case TOKEN_SIN:
+    case TOKEN_COS:
+    case TOKEN_TAN:
+    case TOKEN_ARC_SIN:
+    case TOKEN_ARC_COS:
+    case TOKEN_ARC_TAN:
+    case TOKEN_LOG:
+      return jit_type_of(abstree->children[0], st, type);
+    default:
+      return 0;
+  }
+}
+
+/**
+ * This function emits the code of a node that jit_type_of accepted.
+ * @param      jb - The code being emitted.
+ * @param abstree - The node.
+ * @param      st - The frame the types were taken from.
+ * @return   type - The type of the value (in rax if INT, xmm0 if DOUBLE).
+ */
+var_type jit_emit_node(jit_buffer * jb, ast * abstree, symbol_table * st) {
+  var_type type = INT;
+  union {
+    double d;
+    unsigned long long u;
+  } bits;
+  switch(abstree->value.type) {
+    case TOKEN_INT:
+      jit_emit(jb, "\x48\xB8", 2);                 // mov rax, imm64
+      jit_emit_u64(jb, abstree->value.value.int_value);
+      return INT;
+    case TOKEN_DOUBLE:
+      bits.d = abstree->value.value.double_value;
+      jit_emit(jb, "\x48\xB8", 2);                 // mov rax, imm64
+      jit_emit_u64(jb, bits.u);
+      jit_emit(jb, "\x66\x48\x0F\x6E\xC0", 5);     // movq xmm0, rax
+      return DOUBLE;
+    case TOKEN_VAR:
+      jit_emit(jb, "\x48\x8B\x83", 3);             // mov rax, [rbx + slot]
+      jit_emit_u32(jb, abstree->slot * sizeof(variable *));
+      type = st->udv[abstree->slot]->type;
+      if(type == DOUBLE)
+        jit_emit(jb, "\xF2\x0F\x10\x80", 4);       // movsd xmm0, [rax + off]
+      else
+        jit_emit(jb, "\x48\x8B\x80", 3);           // mov rax, [rax + off]
+      jit_emit_u32(jb, offsetof(struct VARIABLE_T, value));
+      return type;
+    case TOKEN_SIN:
+    case TOKEN_COS:
+    case TOKEN_TAN:
+    case TOKEN_ARC_SIN:
+    case TOKEN_ARC_COS:
+    case TOKEN_ARC_TAN:
+    case TOKEN_LOG:
+      type = jit_emit_node(jb, abstree->children[0], st);
+      if(type == INT)
+        jit_emit(jb, "\xF2\x48\x0F\x2A\xC0", 5);   // cvtsi2sd xmm0, rax
+      jit_emit_call(jb, jit_function_for(abstree->value.type));
+      if(type == INT)
+        jit_emit(jb, "\xF2\x48\x0F\x2C\xC0", 5);   // cvttsd2si rax, xmm0
+      return type;
+    default:
+      break;
+  }
+  type = jit_emit_node(jb, abstree->children[0], st);
+  if(type == DOUBLE) {
+    // sub rsp, 8; movsd [rsp], xmm0
+    jit_emit(jb, "\x48\x83\xEC\x08\xF2\x0F\x11\x04\x24", 9);
+    jb->depth++;
+    jit_emit_node(jb, abstree->children[1], st);
+    // movapd xmm1, xmm0; movsd xmm0, [rsp]; add rsp, 8
+    jit_emit(jb, "\x66\x0F\x28\xC8\xF2\x0F\x10\x04\x24\x48\x83\xC4\x08", 13);
+    jb->depth--;
+    switch(abstree->value.type) {
+      case TOKEN_PLUS:  jit_emit(jb, "\xF2\x0F\x58\xC1", 4); break; // addsd
+      case TOKEN_MINUS: jit_emit(jb, "\xF2\x0F\x5C\xC1", 4); break; // subsd
+      case TOKEN_MULT:  jit_emit(jb, "\xF2\x0F\x59\xC1", 4); break; // mulsd
+      case TOKEN_DIV:   jit_emit(jb, "\xF2\x0F\x5E\xC1", 4); break; // divsd
+      default: jit_emit_call(jb, jit_function_for(TOKEN_POWER)); break;
+    }
+    return DOUBLE;
+  }
+  jit_emit(jb, "\x50", 1);                         // push rax
+  jb->depth++;
+  jit_emit_node(jb, abstree->children[1], st);
+  jit_emit(jb, "\x48\x89\xC1\x58", 4);             // mov rcx, rax; pop rax
+  jb->depth--;
+  switch(abstree->value.type) {
+    case TOKEN_PLUS:  jit_emit(jb, "\x48\x01\xC8", 3); break;     // add
+    case TOKEN_MINUS: jit_emit(jb, "\x48\x29\xC8", 3); break;     // sub
+    case TOKEN_MULT:  jit_emit(jb, "\x48\x0F\xAF\xC1", 4); break; // imul
+    case TOKEN_DIV:
+      // test rcx, rcx; jnz over the bail out, which returns 1 from the
+      // function (mov eax, 1; mov rsp, r13; pop r13; pop r12; pop rbx; ret)
+      jit_emit(jb, "\x48\x85\xC9\x75\x0E", 5);
+      jit_emit(jb, "\xB8\x01\x00\x00\x00\x4C\x89\xEC\x41\x5D\x41\x5C\x5B\xC3",
+          14);
+      // cmp rcx, -1; jne over to the idiv; neg rax; jmp past it, so that
+      // LLONG_MIN / -1 wraps around (as int_div does) instead of trapping
+      jit_emit(jb, "\x48\x83\xF9\xFF\x75\x05\x48\xF7\xD8\xEB\x05", 11);
+      jit_emit(jb, "\x48\x99\x48\xF7\xF9", 5);     // cqo; idiv rcx
+      break;
+    default:
+      // cvtsi2sd xmm0, rax; cvtsi2sd xmm1, rcx; pow; cvttsd2si rax, xmm0
+      // (NaN or out of range gives LLONG_MIN, as double_to_int does)
+      jit_emit(jb, "\xF2\x48\x0F\x2A\xC0\xF2\x48\x0F\x2A\xC9", 10);
+      jit_emit_call(jb, jit_function_for(TOKEN_POWER));
+      jit_emit(jb, "\xF2\x48\x0F\x2C\xC0", 5);
+      break;
+  }
+  return INT;
+}
+
+/**
+ * This function emits a call to a C function, keeping the stack aligned to
+ * 16 bytes as the ABI requires.
+ * @param jb - The code being emitted.
+ * @param fn - The function to be called.
+ * @return N/a
+ */
+void jit_emit_call(jit_buffer * jb, jit_callee fn) {
+  if(jb->depth % 2)
+    jit_emit(jb, "\x48\x83\xEC\x08", 4);           // sub rsp, 8
+  jit_emit(jb, "\x48\xB8", 2);                     // mov rax, fn
+  jit_emit_u64(jb, (unsigned long long)(size_t)fn);
+  jit_emit(jb, "\xFF\xD0", 2);                     // call rax
+  if(jb->depth % 2)
+    jit_emit(jb, "\x48\x83\xC4\x08", 4);           // add rsp, 8
+}
+
+/**
+ * This function appends bytes to the code being emitted.
+ * @param    jb - The code being emitted.
+ * @param bytes - The bytes.
+ * @param     n - The number of bytes.
+ * @return  N/a
+ */
+void jit_emit(jit_buffer * jb, const char * bytes, size_t n) {
+  if(jb->len + n > jb->cap) {
+    while(jb->len + n > jb->cap)
+      jb->cap *= 2;
+    jb->bytes = realloc(jb->bytes, jb->cap);
+  }
+  memcpy(jb->bytes + jb->len, bytes, n);
+  jb->len += n;
+}
+
+/**
+ * This function appends a 32 bit little endian value to the code.
+ * @param    jb - The code being emitted.
+ * @param value - The value.
+ * @return  N/a
+ */
+void jit_emit_u32(jit_buffer * jb, unsigned int value) {
+  char bytes[4];
+  for(int i = 0; i < 4; i++)
+    bytes[i] = (value >> (8 * i)) & 0xFF;
+  jit_emit(jb, bytes, 4);
+}
+
+/**
+ * This function appends a 64 bit little endian value to the code.
+ * @param    jb - The code being emitted.
+ * @param value - The value.
+ * @return  N/a
+ */
+void jit_emit_u64(jit_buffer * jb, unsigned long long value) {
+  char bytes[8];
+  for(int i = 0; i < 8; i++)
+    bytes[i] = (value >> (8 * i)) & 0xFF;
+  jit_emit(jb, bytes, 8);
+}
+
+/**
+ * This function gives the libm function of a token.
+ * @param type - The type of the token (a math function or TOKEN_POWER).
+ * @return  .\ - The function.
+ */
+jit_callee jit_function_for(token_type type) {
+  switch(type) {
+    case TOKEN_SIN:     return (jit_callee)sin;
+    case TOKEN_COS:     return (jit_callee)cos;
+    case TOKEN_TAN:     return (jit_callee)tan;
+    case TOKEN_ARC_SIN: return (jit_callee)asin;
+    case TOKEN_ARC_COS: return (jit_callee)acos;
+    case TOKEN_ARC_TAN: return (jit_callee)atan;
+    case TOKEN_LOG:     return (jit_callee)log;
+    default:            return (jit_callee)pow;
+  }
+}
+
+/**
+ * This function copies emitted code into executable memory.  A region is
+ * only made writable while the code is copied into it.
+ * @param  j - The jit.
+ * @param jb - The code.
+ * @return entry - The entry point of the code, NULL if no memory could be
+ *                 mapped.
+ */
+jit_entry jit_install(jit * j, jit_buffer * jb) {
+  jit_region * r = j->regions;
+  jit_entry entry = NULL;
+  void * code = NULL;
+  if(!r || r->used + jb->len > r->size) {
+    r = calloc(1, sizeof(struct JIT_REGION_T));
+    r->size = JIT_REGION_SIZE;
+    while(r->size < jb->len)
+      r->size *= 2;
+    code = mmap(NULL, r->size, PROT_READ | PROT_EXEC,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(code == MAP_FAILED) {
+      free(r);
+      return NULL;
+    }
+    r->code = code;
+    r->used = 0;
+    r->next = j->regions;
+    j->regions = r;
+  }
+  if(mprotect(r->code, r->size, PROT_READ | PROT_WRITE))
+    return NULL;
+  memcpy(r->code + r->used, jb->bytes, jb->len);
+  mprotect(r->code, r->size, PROT_READ | PROT_EXEC);
+  code = r->code + r->used;
+  // Code is 16 byte aligned
+  r->used = (r->used + jb->len + 15) & ~(size_t)15;
+  // The POSIX way of turning an address into a function (as with dlsym)
+  *(void **)&entry = code;
+  return entry;
+}
+
+/**
+ * This function runs a compiled statement, if the variables it reads still
+ * have the types it was compiled for.
+ * @param     jf - The compiled statement.
+ * @param     st - The frame.
+ * @param result - Set to the value of the statement.
+ * @return    .\ - 1 if it ran, 0 if the interpreter has to run the statement
+ *                 instead.
+ */
+int jit_run(jit_function * jf, symbol_table ** st, ast_result * result) {
+  variable ** udv = st[0]->udv;
+  ast_result value = {0};
+  for(int i = 0; i < jf->qty_guards; i++)
+    if(!udv[jf->guard_slots[i]]->is_set
+        || udv[jf->guard_slots[i]]->type != jf->guard_types[i])
+      return 0;
+  value.type = jf->type;
+  if(jf->entry(udv, &value.value))
+    return 0;
+  *result = jf->assign_slot == -1 ? value
+    : ast_result_assign_slot(jf->assign_slot, value, st);
+  return 1;
+}
+
+/**
+ * This function forgets every compiled function (their memory is reused).
+ * @param    j - The jit.
+ * @return N/a
+ */
+void reset_jit(jit * j) {
+  for(jit_region * r = j->regions; r; r = r->next)
+    r->used = 0;
+  j->qty_functions = 0;
+}
+
+/**
+ * This function frees a jit and unmaps its code.
+ * @param    j - The jit to be freed.
+ * @return N/a
+ */
+void free_jit(jit * j) {
+  jit_region * next = NULL;
+  if(j) {
+    for(jit_region * r = j->regions; r; r = next) {
+      next = r->next;
+      munmap(r->code, r->size);
+      free(r);
+    }
+    free(j);
+  }
+}
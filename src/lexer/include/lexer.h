@@ -13,29 +13,136 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
-#include "../../token/include/token_stack.h"
-#include "../../main/include/constants.h"
+#include <limits.h>
+#include "../../token/include/token_buffer.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/** The longest double literal that is parsed without allocating */
+#define MAX_NUM_LEN 64
+/** Whether a byte of a class can continue a word */
+#define IS_WORD_CLASS(cc) ((cc) >= CC_ALPHA && (cc) <= CC_DIGIT)
+/** Whether a byte of a class can continue a number */
+#define IS_NUMBER_CLASS(cc) ((cc) >= CC_DIGIT && (cc) <= CC_DOT)
+#if defined(__SSE2__)
+/**
+ * The bytes of a vector in the ASCII range [lo, hi] (the compare is signed so
+ * bytes of 0x80 and over are never in range).
+ */
+#define IN_RANGE_128(v, lo, hi) _mm_and_si128( \
+    _mm_cmpgt_epi8((v), _mm_set1_epi8((lo) - 1)), \
+    _mm_cmplt_epi8((v), _mm_set1_epi8((hi) + 1)))
+#endif
+#if defined(__AVX2__)
+/** The bytes of a vector in the ASCII range [lo, hi] (see IN_RANGE_128) */
+#define IN_RANGE_256(v, lo, hi) _mm256_and_si256( \
+    _mm256_cmpgt_epi8((v), _mm256_set1_epi8((lo) - 1)), \
+    _mm256_cmpgt_epi8(_mm256_set1_epi8((hi) + 1), (v)))
+#endif
+
+/**
+ * The classes of the bytes of a source.  The classes a word is made of
+ * (CC_ALPHA to CC_DIGIT) and a number is made of (CC_DIGIT to CC_DOT) are
+ * consecutive so either is a range check.  Every operator character has a
+ * class of its own.
+ */
+typedef enum {
+  CC_INVALID,
+  CC_SPACE,
+  CC_END,
+  CC_QUOTE,
+  CC_ALPHA,
+  CC_UNDERSCORE,
+  CC_DIGIT,
+  CC_DOT,
+  CC_EQ,
+  CC_GT,
+  CC_LT,
+  CC_BAR,
+  CC_L_PAREN,
+  CC_R_PAREN,
+  CC_L_BRACKET,
+  CC_R_BRACKET,
+  CC_CARET,
+  CC_PLUS,
+  CC_MINUS,
+  CC_STAR,
+  CC_SLASH,
+  CC_COMMA,
+  QTY_CHAR_CLASSES
+} char_class;
+
+/**
+ * The states of the DFA that lexes operators.  OS_STOP is the absence of a
+ * transition.
+ */
+typedef enum {
+  OS_STOP,
+  OS_START,
+  OS_ASSIGN,
+  OS_EQUALITY,
+  OS_GT,
+  OS_GT_EQ,
+  OS_LT,
+  OS_LT_EQ,
+  OS_BAR,
+  OS_L_OR,
+  OS_L_PAREN,
+  OS_R_PAREN,
+  OS_L_BRACKET,
+  OS_R_BRACKET,
+  OS_POWER,
+  OS_PLUS,
+  OS_MINUS,
+  OS_MULT,
+  OS_DIV,
+  OS_COMMA,
+  QTY_OPERATOR_STATES
+} operator_state;
+
+extern const unsigned char CHAR_CLASS[256];
+extern const unsigned char OPERATOR_TRANSITIONS[QTY_OPERATOR_STATES]
+    [QTY_CHAR_CLASSES];
+extern const token_type OPERATOR_ACCEPT[QTY_OPERATOR_STATES];
 
 /**
  * This structure is used in the lexical analysis of the user input
  */
 typedef struct LEXER_T {
-  /** The source from which tokens are parsed */
-  char * src;
+  /** The source from which tokens are parsed (not owned by the lexer) */
+  const char * src;
+  /** The length of the source */
+  size_t len;
   /** The current index up to which has been parsed */
-  int curr_index;
-  /** The current character being parsed */
+  size_t curr_index;
+  /** The index at which the current line starts */
+  size_t line_start;
+  /** The number of the current line (starting at 1) */
+  int line_no;
+  /** The current character being parsed ('\0' past the end of the source) */
   char c;
 } lexer;
 
-lexer * init_lexer(char * src);
-token_stack * lex_source(lexer * l);
-token * lex_next_token(lexer * l);
-token * lex_number(lexer * l);
-token * lex_word(lexer * l);
-token * lex_string(lexer * l);
+lexer * init_lexer(const char * src, size_t len);
+void lex_source(lexer * l, token_buffer * tb);
+int lex_line_equals(lexer * l, const char * line);
+int lex_at_end(lexer * l);
+token lex_next_token(lexer * l);
+token lex_operator(lexer * l);
+token lex_number(lexer * l);
+token lex_word(lexer * l);
+token_type classify_word(const char * word, size_t len);
+token lex_string(lexer * l);
 void lex_advance(lexer * l);
+void lex_skip_to(lexer * l, size_t index);
 void lex_whitespace(lexer * l);
 void free_lexer(lexer * l);
+size_t scan_whitespace(const char * src, size_t index, size_t len);
+size_t scan_word(const char * src, size_t index, size_t len);
+size_t scan_number(const char * src, size_t index, size_t len);
+size_t scan_string(const char * src, size_t index, size_t len);
 
 #endif
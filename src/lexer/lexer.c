@@ -10,210 +10,313 @@
 #include"include/lexer.h"
 
 /**
- * This function initializes a lexer given a certain src to lex
+ * The class of every byte, a byte is classified with a single load.  Bytes
+ * that can not appear outside of a string are CC_INVALID.
+ */
+const unsigned char CHAR_CLASS[256] = {
+  [' '] = CC_SPACE, ['\t'] = CC_SPACE,
+  ['\n'] = CC_END, ['\r'] = CC_END, ['\0'] = CC_END,
+  ['"'] = CC_QUOTE, ['_'] = CC_UNDERSCORE, ['.'] = CC_DOT,
+  ['a'] = CC_ALPHA, ['b'] = CC_ALPHA, ['c'] = CC_ALPHA, ['d'] = CC_ALPHA,
+  ['e'] = CC_ALPHA, ['f'] = CC_ALPHA, ['g'] = CC_ALPHA, ['h'] = CC_ALPHA,
+  ['i'] = CC_ALPHA, ['j'] = CC_ALPHA, ['k'] = CC_ALPHA, ['l'] = CC_ALPHA,
+  ['m'] = CC_ALPHA, ['n'] = CC_ALPHA, ['o'] = CC_ALPHA, ['p'] = CC_ALPHA,
+  ['q'] = CC_ALPHA, ['r'] = CC_ALPHA, ['s'] = CC_ALPHA, ['t'] = CC_ALPHA,
+  ['u'] = CC_ALPHA, ['v'] = CC_ALPHA, ['w'] = CC_ALPHA, ['x'] = CC_ALPHA,
+  ['y'] = CC_ALPHA, ['z'] = CC_ALPHA,
+  ['A'] = CC_ALPHA, ['B'] = CC_ALPHA, ['C'] = CC_ALPHA, ['D'] = CC_ALPHA,
+  ['E'] = CC_ALPHA, ['F'] = CC_ALPHA, ['G'] = CC_ALPHA, ['H'] = CC_ALPHA,
+  ['I'] = CC_ALPHA, ['J'] = CC_ALPHA, ['K'] = CC_ALPHA, ['L'] = CC_ALPHA,
+  ['M'] = CC_ALPHA, ['N'] = CC_ALPHA, ['O'] = CC_ALPHA, ['P'] = CC_ALPHA,
+  ['Q'] = CC_ALPHA, ['R'] = CC_ALPHA, ['S'] = CC_ALPHA, ['T'] = CC_ALPHA,
+  ['U'] = CC_ALPHA, ['V'] = CC_ALPHA, ['W'] = CC_ALPHA, ['X'] = CC_ALPHA,
+  ['Y'] = CC_ALPHA, ['Z'] = CC_ALPHA,
+  ['0'] = CC_DIGIT, ['1'] = CC_DIGIT, ['2'] = CC_DIGIT, ['3'] = CC_DIGIT,
+  ['4'] = CC_DIGIT, ['5'] = CC_DIGIT, ['6'] = CC_DIGIT, ['7'] = CC_DIGIT,
+  ['8'] = CC_DIGIT, ['9'] = CC_DIGIT,
+  ['='] = CC_EQ, ['>'] = CC_GT, ['<'] = CC_LT, ['|'] = CC_BAR,
+  ['('] = CC_L_PAREN, [')'] = CC_R_PAREN,
+  ['['] = CC_L_BRACKET, [']'] = CC_R_BRACKET,
+  ['^'] = CC_CARET, ['+'] = CC_PLUS, ['-'] = CC_MINUS, ['*'] = CC_STAR,
+  ['/'] = CC_SLASH, [','] = CC_COMMA
+};
+
+/**
+ * The transitions of the operator DFA: the state reached from a state on a
+ * class of byte.  Every missing transition is OS_STOP, which ends the
+ * operator, so the longest operator is always taken.
+ */
+const unsigned char OPERATOR_TRANSITIONS[QTY_OPERATOR_STATES]
+    [QTY_CHAR_CLASSES] = {
+  [OS_START] = {
+    [CC_EQ] = OS_ASSIGN, [CC_GT] = OS_GT, [CC_LT] = OS_LT, [CC_BAR] = OS_BAR,
+    [CC_L_PAREN] = OS_L_PAREN, [CC_R_PAREN] = OS_R_PAREN,
+    [CC_L_BRACKET] = OS_L_BRACKET, [CC_R_BRACKET] = OS_R_BRACKET,
+    [CC_CARET] = OS_POWER, [CC_PLUS] = OS_PLUS, [CC_MINUS] = OS_MINUS,
+    [CC_STAR] = OS_MULT, [CC_SLASH] = OS_DIV, [CC_COMMA] = OS_COMMA
+  },
+  [OS_ASSIGN] = {[CC_EQ] = OS_EQUALITY},
+  [OS_GT]     = {[CC_EQ] = OS_GT_EQ},
+  [OS_LT]     = {[CC_EQ] = OS_LT_EQ},
+  [OS_BAR]    = {[CC_BAR] = OS_L_OR}
+};
+
+/**
+ * The token an operator ending in a state is, TOKEN_VAR (never an operator)
+ * marks a state that is not accepting.
+ */
+const token_type OPERATOR_ACCEPT[QTY_OPERATOR_STATES] = {
+  [OS_ASSIGN]    = TOKEN_ASSIGN,    [OS_EQUALITY]  = TOKEN_EQUALITY,
+  [OS_GT]        = TOKEN_GT,        [OS_GT_EQ]     = TOKEN_GT_EQ,
+  [OS_LT]        = TOKEN_LT,        [OS_LT_EQ]     = TOKEN_LT_EQ,
+  [OS_L_OR]      = TOKEN_L_OR,      [OS_L_PAREN]   = TOKEN_L_PAREN,
+  [OS_R_PAREN]   = TOKEN_R_PAREN,   [OS_L_BRACKET] = TOKEN_L_BRACKET,
+  [OS_R_BRACKET] = TOKEN_R_BRACKET, [OS_POWER]     = TOKEN_POWER,
+  [OS_PLUS]      = TOKEN_PLUS,      [OS_MINUS]     = TOKEN_MINUS,
+  [OS_MULT]      = TOKEN_MULT,      [OS_DIV]       = TOKEN_DIV,
+  [OS_COMMA]     = TOKEN_COMMA
+};
+
+/**
+ * This function initializes a lexer given a certain src to lex.  The lexer
+ * works directly on src (which need not be NUL terminated) so src has to
+ * outlive the lexer.
  * @param src - the source to be lexed
+ * @param len - the length of the source
  * @return  l - the new lexer
  */
-lexer * init_lexer(char * src) {
+lexer * init_lexer(const char * src, size_t len) {
   lexer * l = calloc(1, sizeof(struct LEXER_T));
-  size_t len = (strnlen(src, MAX_TOK_LEN) + 1);
-  l->src = calloc(len, sizeof(char));
-  strncpy(l->src, src, len);
+  l->src = src;
+  l->len = len;
   l->curr_index = 0;
-  l->c = l->src[l->curr_index];
+  l->line_start = 0;
+  l->line_no = 1;
+  l->c = l->len > 0 ? l->src[l->curr_index] : '\0';
   return l;
 }
 
 /**
- * This function makes a token_stack from the source contained by lexer l
+ * This function fills a token_buffer with the current line of the source
+ * contained by lexer l, the lexer is left at the start of the next line.
  * @param   l - the lexer containing the source from the user
- * @return ts - the token_stack that is reflective of the source
+ * @param  tb - the token_buffer to be filled (it is cleared first)
+ * @return N/a
  */
-token_stack * lex_source(lexer * l) {
+void lex_source(lexer * l, token_buffer * tb) {
+  clear_token_buffer(tb);
   /**
-   * NOTE: that on an empty input, l->c will be a new line thus this is
-   * sufficient
+   * NOTE: that on an empty input, l->c will be a new line (or the end of the
+   * source) thus this is sufficient
    */
-  token_stack * ts = init_token_stack(lex_next_token(l));
-  while(l->c != '\n' && l->c != '\r')
-    ts = push_token(ts, lex_next_token(l));
+  while(l->c != '\n' && l->c != '\r' && l->c != '\0')
+    push_token(tb, lex_next_token(l));
   // The newline itself
-  ts = push_token(ts, lex_next_token(l));
-  return ts;
+  push_token(tb, lex_next_token(l));
+  if(l->c == '\r')
+    lex_advance(l);
+  if(l->c == '\n')
+    lex_advance(l);
+  l->line_start = l->curr_index;
+  l->line_no++;
+}
+
+/**
+ * This function determines if the current line of the source is exactly line.
+ * @param    l - the lexer at the start of a line
+ * @param line - the contents to compare against (without the newline)
+ * @return  .\ - 1 if the current line is line, 0 otherwise
+ */
+int lex_line_equals(lexer * l, const char * line) {
+  size_t len = strlen(line);
+  size_t end = l->curr_index + len;
+  if(end > l->len || memcmp(&l->src[l->curr_index], line, len))
+    return 0;
+  return end == l->len || l->src[end] == '\n' || l->src[end] == '\r';
+}
+
+/**
+ * This function determines if the whole source has been lexed.
+ * @param   l - the lexer
+ * @return .\ - 1 if there is nothing left to lex, 0 otherwise
+ */
+int lex_at_end(lexer * l) {
+  return l->curr_index >= l->len;
 }
 
 /**
  * This function will lex the next token from the source and return the
- * corresponding token.
+ * corresponding token.  The token is picked by the class of its first byte.
  * @param   l - the lexer that contains the source
  * @return .\ - (no explicit name i.e. lambda) the corresponding token
  */
-token * lex_next_token(lexer * l) {
+token lex_next_token(lexer * l) {
   lex_whitespace(l);
-  if(isalpha(l->c))
-    return lex_word(l);
-
-  if(isdigit(l->c))
-    return lex_number(l);
-
-  switch(l->c) {
-    case '=':
-      if(l->src[l->curr_index + 1] == '=') {
-        lex_advance(l);
-        lex_advance(l);
-        return init_token("==", TOKEN_EQUALITY);
-      } else {
-        lex_advance(l);
-        return init_token("=", TOKEN_ASSIGN);
-      }
-    case '>':
-      if(l->src[l->curr_index + 1] == '=') {
-        lex_advance(l);
-        lex_advance(l);
-        return init_token(">=", TOKEN_GT_EQ);
-      } else {
-        lex_advance(l);
-        return init_token(">", TOKEN_GT);
-      }
-    case '<':
-      if(l->src[l->curr_index + 1] == '=') {
-        lex_advance(l);
-        lex_advance(l);
-        return init_token("<=", TOKEN_LT_EQ);
-      } else {
-        lex_advance(l);
-        return init_token("<", TOKEN_LT);
-      }
-    case '|':
-      if(l->src[l->curr_index + 1] == '|') {
-        lex_advance(l);
-        lex_advance(l);
-        return init_token("||", TOKEN_L_OR);
-      } else {
-        fprintf(stderr, "Unmatched \'|\'\nExiting\n");
-        exit(1);
-      }
-    case '(':
-      lex_advance(l);
-      return init_token("(", TOKEN_L_PAREN);
-    case ')':
-      lex_advance(l);
-      return init_token(")", TOKEN_R_PAREN);
-    case '[':
-      lex_advance(l);
-      return init_token("[", TOKEN_L_BRACKET);
-    case ']':
-      lex_advance(l);
-      return init_token("]", TOKEN_R_BRACKET);
-    case '^':
-      lex_advance(l);
-      return init_token("^", TOKEN_POWER);
-    case '+':
-      lex_advance(l);
-      return init_token("+", TOKEN_PLUS);
-    case '-':
-      lex_advance(l);
-      return init_token("-", TOKEN_MINUS);
-    case '*':
-      lex_advance(l);
-      return init_token("*", TOKEN_MULT);
-    case '/':
-      lex_advance(l);
-      return init_token("/", TOKEN_DIV);
-    case ',':
-      lex_advance(l);
-      return init_token(",", TOKEN_COMMA);
-    case '\"':
+  switch(CHAR_CLASS[(unsigned char)l->c]) {
+    case CC_ALPHA:
+      return lex_word(l);
+    case CC_DIGIT:
+      return lex_number(l);
+    case CC_QUOTE:
       lex_advance(l);
       return lex_string(l);
-    case '\n':
-    case '\r':
-      return init_token("0", TOKEN_NEWLINE);
+    case CC_END:
+      // A NUL byte only ends the source when it is past the end of it
+      if(l->c == '\0' && !lex_at_end(l)) {
+        fprintf(stderr, "[LEX_NEXT_TOKEN]: Unrecognized character `\\0` on "
+            "line %d\nExiting\n", l->line_no);
+        exit(1);
+      }
+      return init_token("0", 1, TOKEN_NEWLINE);
+    case CC_INVALID:
+    case CC_SPACE:
+    case CC_UNDERSCORE:
+    case CC_DOT:
+      fprintf(stderr, "[LEX_NEXT_TOKEN]: Unrecognized character `%c` on line "
+          "%d\nExiting\n", l->c, l->line_no);
+      exit(1);
+    default:
+      return lex_operator(l);
   }
-  return NULL;
 }
 
 /**
- * This function lexs a number (both double/int)
+ * This function lexs an operator by running the operator DFA for as long as
+ * it has a transition (i.e. the longest operator is taken).
  * @param    l - the lexer containing the source
- * @return tmp - the token
+ * @return  .\ - the token
  */
-token * lex_number(lexer * l) {
-  size_t len = 0;
-  int start_index = l->curr_index;
-  int dec_flag = 0;
-  while(isdigit(l->c) || l->c == '.') {
+token lex_operator(lexer * l) {
+  size_t start_index = l->curr_index;
+  unsigned char state = OS_START;
+  unsigned char next = OS_STOP;
+  while((next = OPERATOR_TRANSITIONS[state][CHAR_CLASS[(unsigned char)l->c]])
+      != OS_STOP) {
+    state = next;
     lex_advance(l);
-    if(l->c == '.' && dec_flag == 0)
-      dec_flag = 1;
-    len++;
   }
-  char * result = calloc(len + 1, sizeof(char));
-  memcpy(result, &l->src[start_index], len);
-  token * tmp = dec_flag == 0 ? init_token(result, TOKEN_INT)
-    : init_token(result, TOKEN_DOUBLE);
-  if(result)
-    free(result);
-  return tmp;
+  if(OPERATOR_ACCEPT[state] == TOKEN_VAR) {
+    fprintf(stderr, "[LEX_OPERATOR]: Unmatched `%.*s` on line %d\nExiting\n",
+        (int)(l->curr_index - start_index), &l->src[start_index], l->line_no);
+    exit(1);
+  }
+  return init_token(&l->src[start_index], l->curr_index - start_index,
+      OPERATOR_ACCEPT[state]);
 }
 
 /**
- * This function lexs a word
+ * This function lexs a number (both double/int), the value of the number is
+ * parsed into the token.
  * @param    l - the lexer containing the source
  * @return tmp - the token
  */
-token * lex_word(lexer * l) {
-  token * tmp = NULL;
-  size_t len = 0;
-  int start_index = l->curr_index;
-  while(isalpha(l->c) || l->c == '_' || isdigit(l->c)) {
-    lex_advance(l);
-    len++;
+token lex_number(lexer * l) {
+  char buf[MAX_NUM_LEN];
+  char * digits = buf;
+  size_t start_index = l->curr_index;
+  size_t len = scan_number(l->src, start_index, l->len) - start_index;
+  int dec_flag = memchr(&l->src[start_index], '.', len) != NULL;
+  int digit = 0;
+  lex_skip_to(l, start_index + len);
+  token tmp = init_token(&l->src[start_index], len,
+      dec_flag == 0 ? TOKEN_INT : TOKEN_DOUBLE);
+  if(dec_flag == 0) {
+    // Saturates at LLONG_MAX (as strtoll does) rather than overflowing
+    for(size_t i = 0; i < len; i++) {
+      digit = tmp.t_literal[i] - '0';
+      if(tmp.value.int_value > (LLONG_MAX - digit) / 10) {
+        tmp.value.int_value = LLONG_MAX;
+        break;
+      }
+      tmp.value.int_value = 10 * tmp.value.int_value + digit;
+    }
+  } else {
+    // strtod needs a NUL terminated string, the source may not have one
+    if(len >= MAX_NUM_LEN)
+      digits = calloc(len + 1, sizeof(char));
+    memcpy(digits, tmp.t_literal, len);
+    digits[len] = '\0';
+    tmp.value.double_value = strtod(digits, NULL);
+    if(digits != buf)
+      free(digits);
   }
-  char * result = calloc(len + 1, sizeof(char));
-  memcpy(result, &l->src[start_index], len);
-  if(!strncmp("sin", result, MAX_TOK_LEN))
-    tmp = init_token(result, TOKEN_SIN);
-  else if(!strncmp("cos", result, MAX_TOK_LEN))
-    tmp = init_token(result, TOKEN_COS);
-  else if(!strncmp("tan", result, MAX_TOK_LEN))
-    tmp = init_token(result, TOKEN_TAN);
-  else if(!strncmp("arcsin", result, MAX_TOK_LEN))
-    tmp = init_token(result, TOKEN_ARC_SIN);
-  else if(!strncmp("arccos", result, MAX_TOK_LEN))
-    tmp = init_token(result, TOKEN_ARC_COS);
-  else if(!strncmp("arctan", result, MAX_TOK_LEN))
-    tmp = init_token(result, TOKEN_ARC_TAN);
-  else if(!strncmp("log", result, MAX_TOK_LEN))
-    tmp = init_token(result, TOKEN_LOG);
-  else
-    tmp = init_token(result, TOKEN_VAR);
-
-  if(result)
-    free(result);
   return tmp;
 }
 
+/**
+ * This function lexs a word, the name of a variable is interned into an atom.
+ * @param    l - the lexer containing the source
+ * @return tmp - the token
+ */
+token lex_word(lexer * l) {
+  size_t start_index = l->curr_index;
+  size_t len = scan_word(l->src, start_index, l->len) - start_index;
+  lex_skip_to(l, start_index + len);
+  token tmp = init_token(&l->src[start_index], len,
+      classify_word(&l->src[start_index], len));
+  if(tmp.type == TOKEN_VAR)
+    tmp.value.atom_value = intern(tmp.t_literal, tmp.len);
+  return tmp;
+}
+
+/**
+ * This function classifies a word as a keyword or a variable.  The word is
+ * dispatched on its length and then on a character that tells the keywords
+ * of that length apart, so at most one comparison is made whatever the
+ * number of keywords (a new keyword is a new case).
+ * @param word - the word (a slice of the source, not NUL terminated)
+ * @param  len - the length of the word
+ * @return  .\ - the token type of the keyword, TOKEN_VAR if it is not one
+ */
+token_type classify_word(const char * word, size_t len) {
+  switch(len) {
+    case 3:
+      switch(word[0]) {
+        case 's':
+          return memcmp(word, "sin", 3) ? TOKEN_VAR : TOKEN_SIN;
+        case 'c':
+          return memcmp(word, "cos", 3) ? TOKEN_VAR : TOKEN_COS;
+        case 't':
+          return memcmp(word, "tan", 3) ? TOKEN_VAR : TOKEN_TAN;
+        case 'l':
+          return memcmp(word, "log", 3) ? TOKEN_VAR : TOKEN_LOG;
+        default:
+          return TOKEN_VAR;
+      }
+    case 6:
+      if(memcmp(word, "arc", 3))
+        return TOKEN_VAR;
+      switch(word[3]) {
+        case 's':
+          return memcmp(word + 3, "sin", 3) ? TOKEN_VAR : TOKEN_ARC_SIN;
+        case 'c':
+          return memcmp(word + 3, "cos", 3) ? TOKEN_VAR : TOKEN_ARC_COS;
+        case 't':
+          return memcmp(word + 3, "tan", 3) ? TOKEN_VAR : TOKEN_ARC_TAN;
+        default:
+          return TOKEN_VAR;
+      }
+    default:
+      return TOKEN_VAR;
+  }
+}
+
 /**
  * This function lexes a string into a token.
  * @param    l - The lexer from which it should be lexed.
  * @return tmp - The token representative of that string.
  */
-token * lex_string(lexer * l) {
-  token * tmp = NULL;
-  size_t len = 0;
-  int start_index = l->curr_index;
-  while(l->c != '\"') {
-    lex_advance(l);
-    len++;
+token lex_string(lexer * l) {
+  size_t start_index = l->curr_index;
+  size_t len = scan_string(l->src, start_index, l->len) - start_index;
+  lex_skip_to(l, start_index + len);
+  if(l->c != '\"') {
+    fprintf(stderr, "[LEX_STRING]: Unterminated string on line %d\n"
+        "Exiting\n", l->line_no);
+    exit(1);
   }
   lex_advance(l);
-  char * result = calloc(len + 1, sizeof(char));
-  memcpy(result, &l->src[start_index], len);
-  tmp = init_token(result, TOKEN_STRING);
-  if(result)
-    free(result);
-  return tmp;
+  return init_token(&l->src[start_index], len, TOKEN_STRING);
 }
 
 /**
@@ -223,7 +326,19 @@ token * lex_string(lexer * l) {
  */
 void lex_advance(lexer * l) {
   l->curr_index++;
-  l->c = l->src[l->curr_index];
+  l->c = l->curr_index < l->len ? l->src[l->curr_index] : '\0';
+}
+
+/**
+ * This function moves the lexer to an index of the source (i.e. past a run
+ * that has been scanned).
+ * @param     l - the lexer to be moved
+ * @param index - the index to move to (at most the length of the source)
+ * @return  N/a
+ */
+void lex_skip_to(lexer * l, size_t index) {
+  l->curr_index = index;
+  l->c = index < l->len ? l->src[index] : '\0';
 }
 
 /**
@@ -232,8 +347,8 @@ void lex_advance(lexer * l) {
  * @return N/a
  */
 void lex_whitespace(lexer * l) {
-  while(l->c == ' ' || l->c == '\t')
-    lex_advance(l);
+  if(CHAR_CLASS[(unsigned char)l->c] == CC_SPACE)
+    lex_skip_to(l, scan_whitespace(l->src, l->curr_index + 1, l->len));
 }
 
 /**
@@ -242,9 +357,6 @@ void lex_whitespace(lexer * l) {
  * @return N/a
  */
 void free_lexer(lexer * l) {
-  if(l) {
-    if(l->src)
-      free(l->src);
+  if(l)
     free(l);
-  }
 }
@@ -0,0 +1,159 @@
+/**
+ * @file   scan.c
+ * @brief  This file contains the functions that find the end of a run of
+ * bytes of the same kind (whitespace, a word, a number or the body of a
+ * string).  With SSE2/AVX2 a block of 16/32 bytes is tested at once, the
+ * bytes left over (and every byte without SIMD) are tested one at a time.
+ * No function reads at or past len.
+ * @author Matthew C. Lindeman
+ * @date   October 03, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/lexer.h"
+
+/**
+ * This function finds the end of a run of whitespace.
+ * @param   src - the source
+ * @param index - the index the run starts at
+ * @param   len - the length of the source
+ * @return   .\ - the index of the first byte that is not whitespace (len if
+ *                there is none)
+ */
+size_t scan_whitespace(const char * src, size_t index, size_t len) {
+#if defined(__AVX2__)
+  for(; index + 32 <= len; index += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)&src[index]);
+    unsigned int stop = ~(unsigned int)_mm256_movemask_epi8(_mm256_or_si256(
+          _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))));
+    if(stop)
+      return index + __builtin_ctz(stop);
+  }
+#endif
+#if defined(__SSE2__)
+  for(; index + 16 <= len; index += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)&src[index]);
+    unsigned int stop = ~_mm_movemask_epi8(_mm_or_si128(
+          _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+          _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')))) & 0xFFFF;
+    if(stop)
+      return index + __builtin_ctz(stop);
+  }
+#endif
+  while(index < len && CHAR_CLASS[(unsigned char)src[index]] == CC_SPACE)
+    index++;
+  return index;
+}
+
+/**
+ * This function finds the end of a word (letters, digits and underscores).
+ * @param   src - the source
+ * @param index - the index the word starts at
+ * @param   len - the length of the source
+ * @return   .\ - the index of the first byte after the word
+ */
+size_t scan_word(const char * src, size_t index, size_t len) {
+#if defined(__AVX2__)
+  for(; index + 32 <= len; index += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)&src[index]);
+    // Setting 0x20 folds upper case onto lower case (and nothing else into it)
+    __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+    unsigned int stop = ~(unsigned int)_mm256_movemask_epi8(_mm256_or_si256(
+          _mm256_or_si256(IN_RANGE_256(lower, 'a', 'z'),
+            IN_RANGE_256(v, '0', '9')),
+          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'))));
+    if(stop)
+      return index + __builtin_ctz(stop);
+  }
+#endif
+#if defined(__SSE2__)
+  for(; index + 16 <= len; index += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)&src[index]);
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    unsigned int stop = ~_mm_movemask_epi8(_mm_or_si128(
+          _mm_or_si128(IN_RANGE_128(lower, 'a', 'z'),
+            IN_RANGE_128(v, '0', '9')),
+          _mm_cmpeq_epi8(v, _mm_set1_epi8('_')))) & 0xFFFF;
+    if(stop)
+      return index + __builtin_ctz(stop);
+  }
+#endif
+  while(index < len && IS_WORD_CLASS(CHAR_CLASS[(unsigned char)src[index]]))
+    index++;
+  return index;
+}
+
+/**
+ * This function finds the end of a number (digits and decimal points).
+ * @param   src - the source
+ * @param index - the index the number starts at
+ * @param   len - the length of the source
+ * @return   .\ - the index of the first byte after the number
+ */
+size_t scan_number(const char * src, size_t index, size_t len) {
+#if defined(__AVX2__)
+  for(; index + 32 <= len; index += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)&src[index]);
+    unsigned int stop = ~(unsigned int)_mm256_movemask_epi8(_mm256_or_si256(
+          IN_RANGE_256(v, '0', '9'),
+          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.'))));
+    if(stop)
+      return index + __builtin_ctz(stop);
+  }
+#endif
+#if defined(__SSE2__)
+  for(; index + 16 <= len; index += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)&src[index]);
+    unsigned int stop = ~_mm_movemask_epi8(_mm_or_si128(
+          IN_RANGE_128(v, '0', '9'),
+          _mm_cmpeq_epi8(v, _mm_set1_epi8('.')))) & 0xFFFF;
+    if(stop)
+      return index + __builtin_ctz(stop);
+  }
+#endif
+  while(index < len
+      && IS_NUMBER_CLASS(CHAR_CLASS[(unsigned char)src[index]]))
+    index++;
+  return index;
+}
+
+/**
+ * This function finds the end of the body of a string, that is the closing
+ * quote or the end of the line (which ends the string unterminated).
+ * @param   src - the source
+ * @param index - the index just after the opening quote
+ * @param   len - the length of the source
+ * @return   .\ - the index of the first '"', '\n', '\r' or '\0' (len if there
+ *                is none)
+ */
+size_t scan_string(const char * src, size_t index, size_t len) {
+#if defined(__AVX2__)
+  for(; index + 32 <= len; index += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)&src[index]);
+    unsigned int stop = _mm256_movemask_epi8(_mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+          _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')),
+            _mm256_cmpeq_epi8(v, _mm256_setzero_si256()))));
+    if(stop)
+      return index + __builtin_ctz(stop);
+  }
+#endif
+#if defined(__SSE2__)
+  for(; index + 16 <= len; index += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)&src[index]);
+    unsigned int stop = _mm_movemask_epi8(_mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+          _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')),
+            _mm_cmpeq_epi8(v, _mm_setzero_si128()))));
+    if(stop)
+      return index + __builtin_ctz(stop);
+  }
+#endif
+  while(index < len && src[index] != '"' && src[index] != '\n'
+      && src[index] != '\r' && src[index] != '\0')
+    index++;
+  return index;
+}
@@ -1,6 +0,0 @@
-#ifndef CONST_H
-#define CONST_H
-
-#define MAX_TOK_LEN 256
-
-#endif
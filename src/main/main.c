@@ -1,10 +1,12 @@
 #include "../console/include/console.h"
 
 int main(int argc, char *argv[]) {
-  if(argc < 2)
-    repl();
+  options * opts = init_options(argc, argv);
+  if(!opts->file_name)
+    repl(opts);
   else
-    interpret(argv[1]);
+    interpret(opts);
+  free_options(opts);
+  free_intern_table();
   return 0;
 }
-
@@ -10,20 +10,31 @@
 #include "include/abstract_syntax_tree.h"
 
 /**
- * This function initializes a new abstract syntax tree
- * @param t_literal - the literal string of the token
+ * This function initializes a new abstract syntax tree for an operator
+ * @param         a - the arena the tree is allocated from
+ * @param t_literal - the literal string of the token (a string constant)
  * @param      type - the type of the token
- * @return  abstree - the abstract syntax tree
+ * @return       .\ - the abstract syntax tree
  */
-ast * init_ast(char * t_literal, token_type type) {
-  ast * abstree = calloc(1, sizeof(struct AST_T));
-  abstree->value = init_token(t_literal, type);
+ast * init_ast(arena * a, const char * t_literal, token_type type) {
+  return init_ast_from_token(a, init_token(t_literal, strlen(t_literal), type));
+}
+
+/**
+ * This function initializes a new abstract syntax tree from a lexed token
+ * @param       a - the arena the tree is allocated from
+ * @param       t - the token (the tree refers to the same literal)
+ * @return abstree - the abstract syntax tree
+ */
+ast * init_ast_from_token(arena * a, token t) {
+  ast * abstree = arena_alloc(a, sizeof(struct AST_T));
+  abstree->value = t;
   abstree->children = NULL;
-  if(abstree->value->type == TOKEN_INT || abstree->value->type == TOKEN_DOUBLE)
-    abstree->numeric_value = atof(abstree->value->t_literal);
-  else
-    abstree->numeric_value = 0.0;
   abstree->no_children = 0;
+  abstree->slot = -1;
+  abstree->type = INT;
+  abstree->is_typed = 0;
+  abstree->kernel = NULL;
   return abstree;
 }
 
@@ -34,13 +45,15 @@ ast * init_ast(char * t_literal, token_type type) {
  */
 void ast_dump_debug(ast * abstree) {
   printf("AST\n");
-  printf("Token Value: `%s`, Token Type: %d, No Children: %d\n",
-      abstree->value->t_literal, abstree->value->type, abstree->no_children);
+  printf("Token Value: `%.*s`, Token Type: %d, No Children: %d\n",
+      (int)abstree->value.len, abstree->value.t_literal, abstree->value.type,
+      abstree->no_children);
   printf("Children\n");
   for(int i = 0; i < abstree->no_children; i++) {
-    printf("Token Value: `%s`, Token Type: %d, No Children: %d\n",
-        abstree->children[i]->value->t_literal, abstree->children[i]->value->type,
-        abstree->children[i]->no_children);
+    printf("Token Value: `%.*s`, Token Type: %d, No Children: %d\n",
+        (int)abstree->children[i]->value.len,
+        abstree->children[i]->value.t_literal,
+        abstree->children[i]->value.type, abstree->children[i]->no_children);
   }
   printf("End of Children\n\n");
   for(int i = 0; i < abstree->no_children; i++) {
@@ -49,108 +62,176 @@ void ast_dump_debug(ast * abstree) {
 }
 
 /**
- * This function evaluates a tree.
+ * This function evaluates a tree.  A binary operator whose operand types are
+ * known runs its kernel directly, any other goes through the kernel tables.
  * @param abstree - The Abstract Syntax Tree to be evaluated.
  * @param      st - The stack frame for the evaluated tree.
  * @return     .\ - The result of the evaluation.
  */
-ast_result * evaluate_tree(ast * abstree, symbol_table ** st) {
-  int variable_index = 0;
-  switch(abstree->value->type) {
+ast_result evaluate_tree(ast * abstree, symbol_table ** st) {
+  ast_result lhs = {0};
+  if(abstree->kernel) {
+    // The left hand side first (an operand may assign what the other reads)
+    lhs = evaluate_tree(abstree->children[0], st);
+    return abstree->kernel(lhs, evaluate_tree(abstree->children[1], st));
+  }
+  switch(abstree->value.type) {
     case TOKEN_VAR:
-      variable_index = find_variable(st[0], abstree->value->t_literal);
-      if(variable_index != -1)
-        return init_ast_result(st[0]->udv[variable_index]->literal,
-            st[0]->udv[variable_index]->type);
-      fprintf(stderr, "[EVALUATE_TREE]: Variable `%s` not found.\nExiting\n",
-          abstree->value->t_literal);
-      exit(1);
+      return evaluate_variable(abstree, st);
     case TOKEN_INT:
-      return init_ast_result(abstree->value->t_literal, INT);
+      return int_ast_result(abstree->value.value.int_value);
     case TOKEN_DOUBLE:
-      return init_ast_result(abstree->value->t_literal, DOUBLE);
+      return double_ast_result(abstree->value.value.double_value);
     case TOKEN_STRING:
-      return init_ast_result(abstree->value->t_literal, STRING);
-    case TOKEN_PLUS:
-      return ast_result_addition(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_MINUS:
-      return ast_result_subtraction(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_MULT:
-      return ast_result_multiplication(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_DIV:
-      return ast_result_division(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_POWER:
-      return ast_result_power(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
+      return init_ast_result(abstree->value.t_literal, abstree->value.len,
+          STRING);
     case TOKEN_ASSIGN:
-      return ast_result_assign(abstree->children[0]->value->t_literal,
+      if(abstree->slot != -1)
+        return ast_result_assign_slot(abstree->slot,
+            evaluate_tree(abstree->children[1], st), st);
+      if(abstree->children[0]->value.type != TOKEN_VAR) {
+        fprintf(stderr, "[EVALUATE_TREE]: Cannot assign to `%.*s`\nExiting\n",
+            (int)abstree->children[0]->value.len,
+            abstree->children[0]->value.t_literal);
+        exit(1);
+      }
+      return ast_result_assign(abstree->children[0]->value.value.atom_value,
           evaluate_tree(abstree->children[1], st), st);
-    case TOKEN_EQUALITY:
-      return ast_result_equality(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_GT_EQ:
-      return ast_result_gteq(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_GT:
-      return ast_result_gt(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_LT_EQ:
-      return ast_result_lteq(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_LT:
-      return ast_result_lt(evaluate_tree(abstree->children[0], st),
-          evaluate_tree(abstree->children[1], st));
-    case TOKEN_SIN:
-      return ast_result_sin(evaluate_tree(abstree->children[0], st));
-    case TOKEN_COS:
-      return ast_result_cos(evaluate_tree(abstree->children[0], st));
-    case TOKEN_TAN:
-      return ast_result_tan(evaluate_tree(abstree->children[0], st));
-    case TOKEN_ARC_SIN:
-      return ast_result_arc_sin(evaluate_tree(abstree->children[0], st));
-    case TOKEN_ARC_COS:
-      return ast_result_arc_cos(evaluate_tree(abstree->children[0], st));
-    case TOKEN_ARC_TAN:
-      return ast_result_arc_tan(evaluate_tree(abstree->children[0], st));
-    case TOKEN_LOG:
-      return ast_result_log(evaluate_tree(abstree->children[0], st));
     default:
+      if(binary_op_of(abstree->value.type) != QTY_BINARY_OPS) {
+        lhs = evaluate_tree(abstree->children[0], st);
+        return ast_result_binary(binary_op_of(abstree->value.type), lhs,
+            evaluate_tree(abstree->children[1], st));
+      }
+      if(unary_op_of(abstree->value.type) != QTY_UNARY_OPS)
+        return ast_result_unary(unary_op_of(abstree->value.type),
+            evaluate_tree(abstree->children[0], st));
       fprintf(stderr, "[EVALUATE_TREE]: Unhandled Token: `%s`\nExiting\n",
-          token_type_to_string(abstree->value->type));
+          token_type_to_string(abstree->value.type));
       exit(1);
   }
 }
 
-ast * add_child(ast * parent, ast * new_child) {
-  parent->no_children++;
-  if(parent->no_children == 1)
-    parent->children = calloc(1, sizeof(struct AST_T *));
-  else
-    parent->children = realloc(parent->children, parent->no_children
-        * sizeof(struct AST_T *));
-  parent->children[parent->no_children - 1] = new_child;
-  return parent;
+/**
+ * This function gives the binary_op (the row of BINARY_KERNELS) of an operator
+ * token.
+ * @param type - The type of the token.
+ * @return  .\ - The binary_op, QTY_BINARY_OPS if the token is not one.
+ */
+binary_op binary_op_of(token_type type) {
+  switch(type) {
+    case TOKEN_PLUS:     return BINARY_ADD;
+    case TOKEN_MINUS:    return BINARY_SUB;
+    case TOKEN_MULT:     return BINARY_MUL;
+    case TOKEN_DIV:      return BINARY_DIV;
+    case TOKEN_POWER:    return BINARY_POW;
+    case TOKEN_EQUALITY: return BINARY_EQ;
+    case TOKEN_GT_EQ:    return BINARY_GT_EQ;
+    case TOKEN_GT:       return BINARY_GT;
+    case TOKEN_LT_EQ:    return BINARY_LT_EQ;
+    case TOKEN_LT:       return BINARY_LT;
+    default:             return QTY_BINARY_OPS;
+  }
+}
+
+/**
+ * This function gives the unary_op (the row of UNARY_KERNELS) of a function
+ * token.
+ * @param type - The type of the token.
+ * @return  .\ - The unary_op, QTY_UNARY_OPS if the token is not one.
+ */
+unary_op unary_op_of(token_type type) {
+  switch(type) {
+    case TOKEN_SIN:     return UNARY_SIN;
+    case TOKEN_ARC_SIN: return UNARY_ARC_SIN;
+    case TOKEN_COS:     return UNARY_COS;
+    case TOKEN_ARC_COS: return UNARY_ARC_COS;
+    case TOKEN_TAN:     return UNARY_TAN;
+    case TOKEN_ARC_TAN: return UNARY_ARC_TAN;
+    case TOKEN_LOG:     return UNARY_LOG;
+    default:            return QTY_UNARY_OPS;
+  }
+}
+
+/**
+ * This function reads the variable of a TOKEN_VAR node, through its slot if it
+ * has been resolved and by name otherwise.
+ * @param abstree - The TOKEN_VAR node.
+ * @param      st - The stack frame for the evaluated tree.
+ * @return     .\ - The value of the variable.
+ */
+ast_result evaluate_variable(ast * abstree, symbol_table ** st) {
+  int variable_index = abstree->slot != -1 ? abstree->slot
+    : find_variable_atom(st[0], abstree->value.value.atom_value);
+  if(variable_index == -1 || !st[0]->udv[variable_index]->is_set) {
+    fprintf(stderr, "[EVALUATE_TREE]: Variable `%.*s` not found.\nExiting\n",
+        (int)abstree->value.len, abstree->value.t_literal);
+    exit(1);
+  }
+  return init_ast_result_from_variable(st[0]->udv[variable_index]);
 }
 
 /**
- * This function frees an abstract syntax tree
- * @param abstree - the abstract syntax tree to be freed
+ * This function counts the nodes of a tree.
+ * @param abstree - the abstract syntax tree to be counted
+ * @return      n - the number of nodes in the tree
+ */
+int ast_count_nodes(ast * abstree) {
+  int n = 1;
+  for(int i = 0; i < abstree->no_children; i++)
+    n += ast_count_nodes(abstree->children[i]);
+  return n;
+}
+
+/**
+ * This function binds every variable of a tree to a slot of a frame layout,
+ * declaring the names the layout does not have yet.  The target of an
+ * assignment is bound on the assignment node.
+ * @param abstree - the abstract syntax tree to be resolved
+ * @param  layout - the symbol_table whose slots are used
  * @return    N/a
  */
-void free_ast(ast * abstree) {
-  if(abstree) {
-    if(abstree->value)
-      free_token(abstree->value);
-    if(abstree->children) {
-      for(int i = 0; i < abstree->no_children; i++)
-        if(abstree->children[i])
-          free_ast(abstree->children[i]);
-      free(abstree->children);
-    }
-    free(abstree);
+void resolve_tree(ast * abstree, symbol_table * layout) {
+  ast * target = NULL;
+  switch(abstree->value.type) {
+    case TOKEN_VAR:
+      abstree->slot = declare_variable_atom(layout,
+          abstree->value.value.atom_value);
+      break;
+    case TOKEN_ASSIGN:
+      target = abstree->children[0];
+      if(target->value.type != TOKEN_VAR) {
+        fprintf(stderr, "[RESOLVE_TREE]: Cannot assign to `%.*s`\nExiting\n",
+            (int)target->value.len, target->value.t_literal);
+        exit(1);
+      }
+      abstree->slot = declare_variable_atom(layout,
+          target->value.value.atom_value);
+      break;
+    default:
+      break;
+  }
+  for(int i = 0; i < abstree->no_children; i++)
+    resolve_tree(abstree->children[i], layout);
+}
+
+/**
+ * This function appends a child to a tree.  The children array lives in the
+ * arena, so when it is full it is copied into one twice the size.
+ * @param         a - the arena the tree is allocated from
+ * @param    parent - the tree to add the child to
+ * @param new_child - the child to be added
+ * @return   parent - the tree with the new child
+ */
+ast * add_child(arena * a, ast * parent, ast * new_child) {
+  struct AST_T ** children = NULL;
+  int n = parent->no_children;
+  if((n & (n - 1)) == 0) {
+    children = arena_alloc(a, (n ? 2 * n : 1) * sizeof(struct AST_T *));
+    if(n)
+      memcpy(children, parent->children, n * sizeof(struct AST_T *));
+    parent->children = children;
   }
+  parent->children[parent->no_children++] = new_child;
+  return parent;
 }
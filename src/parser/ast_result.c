@@ -2,7 +2,7 @@
  * @file   ast_result.c
  * @brief  This file contains the functions relating to the ast_result data
  * structure.  This structure is used to hold the result of the evaluate_tree
- * set of functions (i.e. type, numeric value, and literal).
+ * set of functions (i.e. type and value).
  * @author Matthew C. Lindeman
  * @date   August 29, 2022
  * @bug    None known
@@ -12,762 +12,1049 @@
 #include "include/ast_result.h"
 
 /**
- * This function initializes an ast_result.
- * @param literal - The literal value of the result.
+ * This function initializes an ast_result from a literal.
+ * @param literal - The literal value of the result (need not be NUL
+ *                  terminated).
+ * @param     len - The length of the literal.
  * @param    type - The variable type of the result of the ast.
  * @return   astr - The initialized ast result.
  */
-ast_result * init_ast_result(char * literal, var_type type) {
-  ast_result * astr = calloc(1, sizeof(struct AST_RESULT_T));
-  size_t len = 0;
-  len = strnlen(literal, MAX_TOK_LEN) + 1;
-  astr->literal = calloc(len, sizeof(char));
-  strncpy(astr->literal, literal, len);
-  astr->type = type;
-  if (astr->type == INT)
-    astr->numeric_value = atoi(literal);
-  else if(astr->type == DOUBLE)
-    astr->numeric_value = atof(literal);
+ast_result init_ast_result(const char * literal, size_t len, var_type type) {
+  char * digits = NULL;
+  ast_result astr = {0};
+  astr.type = type;
+  if(type == STRING) {
+    astr.value.string_value = init_shared_string(literal, len);
+    return astr;
+  }
+  // strtoll/strtod need a NUL terminated string, the literal may not have one
+  digits = strndup(literal, len);
+  if(type == INT)
+    astr.value.int_value = strtoll(digits, NULL, 10);
   else
-    astr->numeric_value = 0;
+    astr.value.double_value = strtod(digits, NULL);
+  free(digits);
   return astr;
 }
 
 /**
- * This function is used in debugging the ast_results.
- * @param astr - The ast_result to be debugged.
- * @return N/a
+ * This function initializes an ast_result with an int value.
+ * @param value - The value of the result.
+ * @return astr - The initialized ast result.
  */
-void ast_result_dump_debug(ast_result * astr) {
-  printf("Ast Result\n");
-  printf("Literal Value: `%s`\n", astr->literal);
-  printf("Numeric Value: %f\n", astr->numeric_value);
-  printf("Type: `%s`\n", var_type_to_string(astr->type));
-  printf("--\n");
+ast_result int_ast_result(long long value) {
+  ast_result astr = {0};
+  astr.type = INT;
+  astr.value.int_value = value;
+  return astr;
 }
 
 /**
- * This function takes an ast_result and prints its value.
- * @param astr - The ast_result to be printed.
- * @return N/a
+ * This function adds two INTs, wrapping around on overflow (two's complement)
+ * rather than leaving it undefined.
+ * @param lhs - The left hand side.
+ * @param rhs - The right hand side.
+ * @return .\ - The sum.
  */
-void ast_print_result(ast_result * astr) {
-  switch(astr->type) {
-    case INT:
-      printf("%d\n", (int)astr->numeric_value);
-      break;
-    case DOUBLE:
-      printf("%f\n", astr->numeric_value);
-      break;
-    case STRING:
-      printf("\"%s\"\n", astr->literal);
-      break;
-  }
+long long int_add(long long lhs, long long rhs) {
+  return (long long)((unsigned long long)lhs + (unsigned long long)rhs);
 }
 
 /**
- * This function adds two ast_results.  Note: This is used to be in conjunction
- * with the evaluate_tree family of functions as it frees each ast_result that
- * is an argument.
- * @param   astr1 - The first argument of addition.
- * @param   astr1 - The second argument of addition.
- * @return result - The result of the addition.
+ * This function subtracts two INTs, wrapping around on overflow.
+ * @param lhs - The left hand side.
+ * @param rhs - The right hand side.
+ * @return .\ - The difference.
  */
-ast_result * ast_result_addition(ast_result * astr1, ast_result * astr2) {
-  size_t one_len = 0;
-  size_t two_len = 0;
-  size_t result_len = 0;
+long long int_sub(long long lhs, long long rhs) {
+  return (long long)((unsigned long long)lhs - (unsigned long long)rhs);
+}
 
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_ADDITION]: Type Mismatch:\n1) %s\n2) %s\nExiting\n",
-        var_type_to_string(astr1->type), var_type_to_string(astr2->type));
-    exit(1);
-  }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
-    case INT:
-      result->numeric_value = astr1->numeric_value + astr2->numeric_value;
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-    case DOUBLE:
-      result->numeric_value = astr1->numeric_value + astr2->numeric_value;
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-    case STRING:
-      one_len = strnlen(astr1->literal, MAX_TOK_LEN);
-      two_len = strnlen(astr2->literal, MAX_TOK_LEN);
-      result_len = one_len + two_len + 1;
-      result->literal = calloc(result_len, sizeof(char));
-      result->type = STRING;
-      strncat(result->literal, astr1->literal, result_len);
-      strncat(result->literal, astr2->literal, result_len);
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-  }
-  return NULL;
+/**
+ * This function multiplies two INTs, wrapping around on overflow.
+ * @param lhs - The left hand side.
+ * @param rhs - The right hand side.
+ * @return .\ - The product.
+ */
+long long int_mul(long long lhs, long long rhs) {
+  return (long long)((unsigned long long)lhs * (unsigned long long)rhs);
 }
 
 /**
- * This function subtracts two ast_results.  Note: This is used to be in
- * conjunction with the evaluate_tree family of functions as it frees each
- * ast_result that is an argument.
- * @param   astr1 - The first argument of subtraction.
- * @param   astr1 - The second argument of subtraction.
- * @return result - The result of the subtraction.
+ * This function divides two INTs (the divisor is not 0).  LLONG_MIN / -1
+ * wraps around to LLONG_MIN instead of trapping, so -1 negates.
+ * @param lhs - The left hand side.
+ * @param rhs - The right hand side.
+ * @return .\ - The quotient.
  */
-ast_result * ast_result_subtraction(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_SUBTRACTION]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
-    exit(1);
-  }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
-    case INT:
-      result->numeric_value = astr1->numeric_value - astr2->numeric_value;
-      result->literal = calloc(qty_digits(result->numeric_value) + 2, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-    case DOUBLE:
-      result->numeric_value = astr1->numeric_value - astr2->numeric_value;
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_SUB]: Subtraction not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+long long int_div(long long lhs, long long rhs) {
+  if(rhs == -1)
+    return int_sub(0, lhs);
+  return lhs / rhs;
 }
 
 /**
- * This function multiplies two ast_results.  Note: This is used to be in
- * conjunction with the evaluate_tree family of functions as it frees each
- * ast_result that is an argument.
- * @param   astr1 - The first argument of multiplication.
- * @param   astr1 - The second argument of multiplication.
- * @return result - The result of the multiplication.
+ * This function truncates a DOUBLE to an INT.  NaN and values out of range
+ * give LLONG_MIN, which is what cvttsd2si gives on x86-64.
+ * @param value - The DOUBLE.
+ * @return   .\ - The INT.
  */
-ast_result * ast_result_multiplication(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_MULTIPLICATION]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
-    exit(1);
-  }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
+long long double_to_int(double value) {
+  if(!(value >= -9223372036854775808.0 && value < 9223372036854775808.0))
+    return LLONG_MIN;
+  return (long long)value;
+}
+
+/**
+ * This function initializes an ast_result with a double value.
+ * @param value - The value of the result.
+ * @return astr - The initialized ast result.
+ */
+ast_result double_ast_result(double value) {
+  ast_result astr = {0};
+  astr.type = DOUBLE;
+  astr.value.double_value = value;
+  return astr;
+}
+
+/**
+ * This function initializes an ast_result with a string value.  The result
+ * takes over the caller's reference to the string.
+ * @param value - The value of the result.
+ * @return astr - The initialized ast result.
+ */
+ast_result string_ast_result(shared_string * value) {
+  ast_result astr = {0};
+  astr.type = STRING;
+  astr.value.string_value = value;
+  return astr;
+}
+
+/**
+ * This function initializes an ast_result from the value of a variable.
+ * @param  var - The variable to be read.
+ * @return  .\ - The new ast_result.
+ */
+ast_result init_ast_result_from_variable(variable * var) {
+  ast_result astr = {0};
+  astr.type = var->type;
+  switch(var->type) {
     case INT:
-      result->numeric_value = astr1->numeric_value * astr2->numeric_value;
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
+      astr.value.int_value = var->value.int_value;
+      break;
     case DOUBLE:
-      result->numeric_value = astr1->numeric_value * astr2->numeric_value;
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
+      astr.value.double_value = var->value.double_value;
+      break;
     case STRING:
-      fprintf(stderr, "[AST_RESULT_MULT]: Multiplication not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
+      astr.value.string_value = retain_shared_string(var->string_value);
+      break;
   }
-  return NULL;
+  return astr;
 }
 
 /**
- * This function divides two ast_results.  Note: This is used to be in
- * conjunction with the evaluate_tree family of functions as it frees each
- * ast_result that is an argument.
- * @param   astr1 - The first argument of division.
- * @param   astr1 - The second argument of division.
- * @return result - The result of the division.
+ * This function copies an ast_result (i.e. takes another reference to the
+ * string if there is one).
+ * @param astr - The ast_result to be copied.
+ * @return  .\ - The copy.
  */
-ast_result * ast_result_division(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_DIVISION]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
-    exit(1);
-  }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
+ast_result copy_ast_result(ast_result astr) {
+  if(astr.type == STRING)
+    retain_shared_string(astr.value.string_value);
+  return astr;
+}
+
+/**
+ * This function formats the value of an ast_result into buf.  This is the
+ * only place numbers are turned into strings.
+ * @param astr - The ast_result to be formatted.
+ * @param  buf - The buffer to be written to.
+ * @param size - The size of buf.
+ * @return  .\ - The number of characters that the full format needs (same as
+ *               snprintf).
+ */
+int ast_result_format(ast_result astr, char * buf, size_t size) {
+  switch(astr.type) {
     case INT:
-      result->numeric_value = astr1->numeric_value / astr2->numeric_value;
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
+      return snprintf(buf, size, "%lld", astr.value.int_value);
     case DOUBLE:
-      result->numeric_value = astr1->numeric_value / astr2->numeric_value;
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
+      return snprintf(buf, size, "%f", astr.value.double_value);
     case STRING:
-      fprintf(stderr, "[AST_RESULT_DIV]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
+      return snprintf(buf, size, "\"%.*s\"",
+          (int)astr.value.string_value->len,
+          shared_string_data(astr.value.string_value));
   }
-  return NULL;
+  return 0;
 }
 
 /**
- * This function takes an ast_result to the power of another ast_result. Note:
- * This is used to be in conjunction with the evaluate_tree family of functions
- * as it frees each ast_result that is an argument.
- * @param   astr1 - The base.
- * @param   astr1 - The power.
- * @return result - The result of the operation.
+ * This function is used in debugging the ast_results.
+ * @param astr - The ast_result to be debugged.
+ * @return N/a
  */
-ast_result * ast_result_power(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_POWER]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
-    exit(1);
-  }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
+void ast_result_dump_debug(ast_result astr) {
+  size_t size = ast_result_format(astr, NULL, 0) + 1;
+  char * buf = calloc(size, sizeof(char));
+  ast_result_format(astr, buf, size);
+  printf("Ast Result\n");
+  printf("Value: `%s`\n", buf);
+  free(buf);
+  printf("Type: `%s`\n", var_type_to_string(astr.type));
+  printf("--\n");
+}
+
+/**
+ * This function takes an ast_result and prints its value.
+ * @param astr - The ast_result to be printed.
+ * @return N/a
+ */
+void ast_print_result(ast_result astr) {
+  switch(astr.type) {
     case INT:
-      result->numeric_value = pow(astr1->numeric_value, astr2->numeric_value);
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
+      printf("%lld\n", astr.value.int_value);
+      break;
     case DOUBLE:
-      result->numeric_value = pow(astr1->numeric_value, astr2->numeric_value);
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
+      printf("%f\n", astr.value.double_value);
+      break;
     case STRING:
-      fprintf(stderr, "[AST_RESULT_DIV]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
+      putchar('"');
+      fwrite(shared_string_data(astr.value.string_value), sizeof(char),
+          astr.value.string_value->len, stdout);
+      printf("\"\n");
+      break;
   }
-  return NULL;
 }
 
 /**
  * This function assigns value to the variable of name var in symbol_table st.
- * @param   var - The name of the variable to be logged in the symbol_table.
+ * @param   var - The atom of the name of the variable.
  * @param value - The value of the new variable.
  * @param    st - The symbol_table for the apprpriate stack frame.
  * @return   .\ - 1::Assignment Worked
- *                0::Assignment Did not Work
  */
-ast_result * ast_result_assign(char * var, ast_result * value,
+ast_result ast_result_assign(const atom * var, ast_result value,
     symbol_table ** st) {
-  int variable_index = find_variable(st[0], var);
-  if(variable_index != -1) {
-    free_variable(st[0]->udv[variable_index]);
-    add_variable_at_index(st[0],
-        init_variable(var, value->literal, value->type), variable_index);
-    if(st[0]->udv[variable_index]) {
-      free_ast_result(value);
-      return init_ast_result("1", INT);
-    }
-  } else {
-    add_variable(st[0], init_variable(var, value->literal, value->type));
-    if(st[0]->udv[st[0]->qty_udv - 1]) {
-      free_ast_result(value);
-      return init_ast_result("1", INT);
-    }
-  }
-  return init_ast_result("0", INT);
+  return ast_result_assign_slot(declare_variable_atom(st[0], var), value, st);
 }
 
 /**
- * This function determines if astr1 has an equal numeric value to
- * the numeric value of astr2 (for strings, it is their length values that are
- * compared).
- * @param      astr1 - The astr to be tested for the equal to property.
- * @param      astr2 - The astr to be tested for the equal to property.
- * @return result::0 - astr1->numeric_value != astr2->numeric_value
- *         result::1 - astr1->numeric_value == astr2->numeric_value
+ * This function assigns value to the variable in a slot of symbol_table st.
+ * @param  slot - The slot of the variable (from declare_variable).
+ * @param value - The value of the variable.
+ * @param    st - The symbol_table for the apprpriate stack frame.
+ * @return   .\ - 1::Assignment Worked
  */
-ast_result * ast_result_equality(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_EQUALITY]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
-    exit(1);
-  }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
+ast_result ast_result_assign_slot(int slot, ast_result value,
+    symbol_table ** st) {
+  switch(value.type) {
     case INT:
+      assign_variable_at(st[0], slot, &value.value.int_value, INT);
+      break;
     case DOUBLE:
-      result->numeric_value
-        = astr1->numeric_value == astr2->numeric_value ? 1 : 0;
-      result->literal = calloc(1, sizeof(char));
-      result->literal[0] = result->numeric_value == 1 ? '1' : '0';
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
+      assign_variable_at(st[0], slot, &value.value.double_value, DOUBLE);
+      break;
     case STRING:
-      result->numeric_value
-        = strncmp(astr1->literal, astr2->literal, MAX_TOK_LEN)
-        == 0 ? 1 : 0;
-      result->literal = calloc(1, sizeof(char));
-      result->literal[0] = result->numeric_value == 1 ? '1' : '0';
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
+      assign_variable_at(st[0], slot, value.value.string_value, STRING);
+      break;
   }
-  return NULL;
+  free_ast_result(value);
+  return int_ast_result(1);
 }
 
 /**
- * This function determines if astr1 has a greater or equal numeric value to
- * the numeric value of astr2 (i.e. undefined for strings).
- * @param      astr1 - The astr to be tested for the greater or equal to
- * property.
- * @param      astr2 - The astr to be tested for the less than property.
- * @return result::0 - astr1->numeric_value < astr2->numeric_value
- *         result::1 - astr1->numeric_value >= astr2->numeric_value
+ * The kernels of the binary operators, by operator and the types of the left
+ * and right hand sides.  An INT operand meeting a DOUBLE one is promoted to a
+ * DOUBLE.  A missing kernel is a type error.  Like the other ast_result
+ * functions a kernel frees its arguments.
+ */
+const ast_result_kernel BINARY_KERNELS[QTY_BINARY_OPS][QTY_VAR_TYPES]
+    [QTY_VAR_TYPES] = {
+  [BINARY_ADD] = {
+    [INT][INT] = ast_result_add_ii,
+    [INT][DOUBLE] = ast_result_add_id,
+    [DOUBLE][INT] = ast_result_add_di,
+    [DOUBLE][DOUBLE] = ast_result_add_dd,
+    [STRING][STRING] = ast_result_add_ss,
+  },
+  [BINARY_SUB] = {
+    [INT][INT] = ast_result_sub_ii,
+    [INT][DOUBLE] = ast_result_sub_id,
+    [DOUBLE][INT] = ast_result_sub_di,
+    [DOUBLE][DOUBLE] = ast_result_sub_dd,
+  },
+  [BINARY_MUL] = {
+    [INT][INT] = ast_result_mul_ii,
+    [INT][DOUBLE] = ast_result_mul_id,
+    [DOUBLE][INT] = ast_result_mul_di,
+    [DOUBLE][DOUBLE] = ast_result_mul_dd,
+  },
+  [BINARY_DIV] = {
+    [INT][INT] = ast_result_div_ii,
+    [INT][DOUBLE] = ast_result_div_id,
+    [DOUBLE][INT] = ast_result_div_di,
+    [DOUBLE][DOUBLE] = ast_result_div_dd,
+  },
+  [BINARY_POW] = {
+    [INT][INT] = ast_result_pow_ii,
+    [INT][DOUBLE] = ast_result_pow_id,
+    [DOUBLE][INT] = ast_result_pow_di,
+    [DOUBLE][DOUBLE] = ast_result_pow_dd,
+  },
+  [BINARY_EQ] = {
+    [INT][INT] = ast_result_eq_ii,
+    [INT][DOUBLE] = ast_result_eq_id,
+    [DOUBLE][INT] = ast_result_eq_di,
+    [DOUBLE][DOUBLE] = ast_result_eq_dd,
+    [STRING][STRING] = ast_result_eq_ss,
+  },
+  [BINARY_GT_EQ] = {
+    [INT][INT] = ast_result_gteq_ii,
+    [INT][DOUBLE] = ast_result_gteq_id,
+    [DOUBLE][INT] = ast_result_gteq_di,
+    [DOUBLE][DOUBLE] = ast_result_gteq_dd,
+  },
+  [BINARY_GT] = {
+    [INT][INT] = ast_result_gt_ii,
+    [INT][DOUBLE] = ast_result_gt_id,
+    [DOUBLE][INT] = ast_result_gt_di,
+    [DOUBLE][DOUBLE] = ast_result_gt_dd,
+  },
+  [BINARY_LT_EQ] = {
+    [INT][INT] = ast_result_lteq_ii,
+    [INT][DOUBLE] = ast_result_lteq_id,
+    [DOUBLE][INT] = ast_result_lteq_di,
+    [DOUBLE][DOUBLE] = ast_result_lteq_dd,
+  },
+  [BINARY_LT] = {
+    [INT][INT] = ast_result_lt_ii,
+    [INT][DOUBLE] = ast_result_lt_id,
+    [DOUBLE][INT] = ast_result_lt_di,
+    [DOUBLE][DOUBLE] = ast_result_lt_dd,
+  },
+};
+
+/**
+ * The kernels of the functions, by function and the type of the operand (a
+ * function keeps the type of its operand).
  */
-ast_result * ast_result_gteq(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_GTEQ]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
+const ast_result_unary_kernel UNARY_KERNELS[QTY_UNARY_OPS][QTY_VAR_TYPES] = {
+  [UNARY_SIN] = {
+    [INT] = ast_result_sin_i,
+    [DOUBLE] = ast_result_sin_d,
+  },
+  [UNARY_ARC_SIN] = {
+    [INT] = ast_result_arc_sin_i,
+    [DOUBLE] = ast_result_arc_sin_d,
+  },
+  [UNARY_COS] = {
+    [INT] = ast_result_cos_i,
+    [DOUBLE] = ast_result_cos_d,
+  },
+  [UNARY_ARC_COS] = {
+    [INT] = ast_result_arc_cos_i,
+    [DOUBLE] = ast_result_arc_cos_d,
+  },
+  [UNARY_TAN] = {
+    [INT] = ast_result_tan_i,
+    [DOUBLE] = ast_result_tan_d,
+  },
+  [UNARY_ARC_TAN] = {
+    [INT] = ast_result_arc_tan_i,
+    [DOUBLE] = ast_result_arc_tan_d,
+  },
+  [UNARY_LOG] = {
+    [INT] = ast_result_log_i,
+    [DOUBLE] = ast_result_log_d,
+  },
+};
+
+/**
+ * This function applies a binary operator to two ast_results.  Note: This is
+ * used in conjunction with the evaluate_tree family of functions as it frees
+ * each ast_result that is an argument.
+ * @param    op - The operator.
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The result of the operation.
+ */
+ast_result ast_result_binary(binary_op op, ast_result astr1,
+    ast_result astr2) {
+  ast_result_kernel kernel = BINARY_KERNELS[op][astr1.type][astr2.type];
+  if(!kernel) {
+    if(astr1.type != astr2.type)
+      fprintf(stderr, "[AST_RESULT_BINARY]: Type Mismatch for %s:\n1) %s\n"
+          "2) %s\nExiting\n", binary_op_to_string(op),
+          var_type_to_string(astr1.type), var_type_to_string(astr2.type));
+    else
+      fprintf(stderr, "[AST_RESULT_BINARY]: %s not Implemented for %ss\n"
+          "Exiting\n", binary_op_to_string(op),
+          var_type_to_string(astr1.type));
     exit(1);
   }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
-    case INT:
-    case DOUBLE:
-      result->numeric_value
-        = astr1->numeric_value >= astr2->numeric_value ? 1 : 0;
-      result->literal = calloc(1, sizeof(char));
-      result->literal[0] = result->numeric_value == 1 ? '1' : '0';
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_GTEQ]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+  return kernel(astr1, astr2);
 }
 
 /**
- * This function determines if astr1 has a greater numeric value to the numeric
- * value of astr2 (i.e. undefined for strings).
- * @param      astr1 - The astr to be tested for the greater than property.
- * @param      astr2 - The astr to be tested for the less than or equal to
- * property.
- * @return result::0 - astr1->numeric_value <= astr2->numeric_value
- *         result::1 - astr1->numeric_value > astr2->numeric_value
+ * This function applies a function (the trig/log family) to an ast_result.
+ * @param   op - The function.
+ * @param astr - The operand.
+ * @return  .\ - The result of the function.
  */
-ast_result * ast_result_gt(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_GT]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
+ast_result ast_result_unary(unary_op op, ast_result astr) {
+  ast_result_unary_kernel kernel = UNARY_KERNELS[op][astr.type];
+  if(!kernel) {
+    fprintf(stderr, "[AST_RESULT_UNARY]: %s not Implemented for %ss\n"
+        "Exiting\n", unary_op_to_string(op), var_type_to_string(astr.type));
     exit(1);
   }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
-    case INT:
-    case DOUBLE:
-      result->numeric_value
-        = astr1->numeric_value > astr2->numeric_value ? 1 : 0;
-      result->literal = calloc(1, sizeof(char));
-      result->literal[0] = result->numeric_value == 1 ? '1' : '0';
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_GT]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+  return kernel(astr);
 }
 
 /**
- * This function determines if astr1 has a lower than or equal to the numeric
- * value of astr2 (i.e. undefined for strings).
- * @param      astr1 - The astr to be tested for the less than or equal to
- * property.
- * @param      astr2 - The astr to be tested for the greater than property.
- * @return result::0 - astr1->numeric_value > astr2->numeric_value
- *         result::1 - astr1->numeric_value <= astr2->numeric_value
+ * This function gives the type of the value of a binary operator from the
+ * types of its operands (if it has a kernel for them).
+ * @param    op - The operator.
+ * @param  lhs - The type of the left hand side.
+ * @param  rhs - The type of the right hand side.
+ * @return  .\ - The type of the value.
  */
-ast_result * ast_result_lteq(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_LTEQ]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
-    exit(1);
+var_type binary_result_type(binary_op op, var_type lhs, var_type rhs) {
+  if(op >= BINARY_EQ)
+    return INT;
+  return lhs == rhs ? lhs : DOUBLE;
+}
+
+/**
+ * This function promotes an INT ast_result to a DOUBLE.
+ * @param astr - The INT.
+ * @return  .\ - The DOUBLE.
+ */
+ast_result promote_ast_result(ast_result astr) {
+  return double_ast_result((double)astr.value.int_value);
+}
+
+/**
+ * This function takes a binary_op and converts it to a const char *
+ * representation.
+ * @param op - The binary_op in question.
+ * @return .\ - The corresponding const char *.
+ */
+const char * binary_op_to_string(binary_op op) {
+  switch(op) {
+    case BINARY_ADD:   return "Addition";
+    case BINARY_SUB:   return "Subtraction";
+    case BINARY_MUL:   return "Multiplication";
+    case BINARY_DIV:   return "Division";
+    case BINARY_POW:   return "Power";
+    case BINARY_EQ:    return "Equality";
+    case BINARY_GT_EQ: return "Comparison";
+    case BINARY_GT:    return "Comparison";
+    case BINARY_LT_EQ: return "Comparison";
+    case BINARY_LT:    return "Comparison";
+    case QTY_BINARY_OPS: break;
   }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
-    case INT:
-    case DOUBLE:
-      result->numeric_value
-        = astr1->numeric_value <= astr2->numeric_value ? 1 : 0;
-      result->literal = calloc(1, sizeof(char));
-      result->literal[0] = result->numeric_value == 1 ? '1' : '0';
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_LTEQ]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
+  fprintf(stderr, "[BINARY_OP_TO_STRING]: Fell Through\nExiting\n");
+  exit(1);
+}
+
+/**
+ * This function takes a unary_op and converts it to a const char *
+ * representation.
+ * @param op - The unary_op in question.
+ * @return .\ - The corresponding const char *.
+ */
+const char * unary_op_to_string(unary_op op) {
+  switch(op) {
+    case UNARY_SIN:     return "Sin";
+    case UNARY_ARC_SIN: return "Arc Sin";
+    case UNARY_COS:     return "Cos";
+    case UNARY_ARC_COS: return "Arc Cos";
+    case UNARY_TAN:     return "Tan";
+    case UNARY_ARC_TAN: return "Arc Tan";
+    case UNARY_LOG:     return "Log";
+    case QTY_UNARY_OPS: break;
   }
-  return NULL;
+  fprintf(stderr, "[UNARY_OP_TO_STRING]: Fell Through\nExiting\n");
+  exit(1);
+}
+
+/**
+ * This function adds two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The sum.
+ */
+ast_result ast_result_add_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(int_add(astr1.value.int_value,
+        astr2.value.int_value));
+}
+
+/**
+ * This function adds two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The sum.
+ */
+ast_result ast_result_add_dd(ast_result astr1, ast_result astr2) {
+  return double_ast_result(astr1.value.double_value
+      + astr2.value.double_value);
+}
+
+/**
+ * This function subtracts two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The difference.
+ */
+ast_result ast_result_sub_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(int_sub(astr1.value.int_value,
+        astr2.value.int_value));
+}
+
+/**
+ * This function subtracts two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The difference.
+ */
+ast_result ast_result_sub_dd(ast_result astr1, ast_result astr2) {
+  return double_ast_result(astr1.value.double_value
+      - astr2.value.double_value);
 }
 
 /**
- * This function determines if astr1 has a lower numeric value than astr2 (i.e.
- * undefined for strings).
- * @param      astr1 - The astr to be tested for the less than property.
- * @param      astr2 - The astr to be tested for the greater than or equal to
- * property.
- * @return result::0 - astr1->numeric_value >= astr2->numeric_value
- *         result::1 - astr1->numeric_value < astr2->numeric_value
+ * This function multiplies two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The product.
  */
-ast_result * ast_result_lt(ast_result * astr1, ast_result * astr2) {
-  if(astr1->type != astr2->type) {
-    fprintf(stderr, "[ASTR_LT]: Type Mismatch:\n1) %s\n2) %s\n"
-      "Exiting\n", var_type_to_string(astr1->type),
-      var_type_to_string(astr2->type));
+ast_result ast_result_mul_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(int_mul(astr1.value.int_value,
+        astr2.value.int_value));
+}
+
+/**
+ * This function multiplies two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The product.
+ */
+ast_result ast_result_mul_dd(ast_result astr1, ast_result astr2) {
+  return double_ast_result(astr1.value.double_value
+      * astr2.value.double_value);
+}
+
+/**
+ * This function divides two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The quotient.
+ */
+ast_result ast_result_div_ii(ast_result astr1, ast_result astr2) {
+  if(astr2.value.int_value == 0) {
+    fprintf(stderr, "[AST_RESULT_DIV]: Integer Division by Zero\nExiting\n");
     exit(1);
   }
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr1->type) {
-    case INT:
-    case DOUBLE:
-      result->numeric_value
-        = astr1->numeric_value < astr2->numeric_value ? 1 : 0;
-      result->literal = calloc(1, sizeof(char));
-      result->literal[0] = result->numeric_value == 1 ? '1' : '0';
-      result->type = INT;
-      free_ast_result(astr1);
-      free_ast_result(astr2);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_LT]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+  return int_ast_result(int_div(astr1.value.int_value,
+        astr2.value.int_value));
 }
 
 /**
- * This function takes the sin of astr.
- * @param    astr - The ast result to take the sin of.
- * @return result - The resulf of the sin.
+ * This function divides two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The quotient.
  */
-ast_result * ast_result_sin(ast_result * astr) {
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr->type) {
-    case INT:
-      result->numeric_value = sin(astr->numeric_value);
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr);
-      return result;
-    case DOUBLE:
-      result->numeric_value = sin(astr->numeric_value);
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_SIN]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+ast_result ast_result_div_dd(ast_result astr1, ast_result astr2) {
+  return double_ast_result(astr1.value.double_value
+      / astr2.value.double_value);
 }
 
 /**
- * This function takes the arc_sin of astr.
- * @param    astr - The ast result to take the arc_sin of.
- * @return result - The resulf of the arc_sin.
+ * This function raises an INT operand to an INT power (types known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The power.
  */
-ast_result * ast_result_arc_sin(ast_result * astr) {
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr->type) {
-    case INT:
-      result->numeric_value = asin(astr->numeric_value);
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr);
-      return result;
-    case DOUBLE:
-      result->numeric_value = asin(astr->numeric_value);
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_ARCSIN]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+ast_result ast_result_pow_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(double_to_int(pow(astr1.value.int_value,
+        astr2.value.int_value)));
 }
 
 /**
- * This function takes the cos of astr.
- * @param    astr - The ast result to take the cos of.
- * @return result - The resulf of the cos.
+ * This function raises a DOUBLE operand to a DOUBLE power (types known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The power.
  */
-ast_result * ast_result_cos(ast_result * astr) {
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr->type) {
-    case INT:
-      result->numeric_value = cos(astr->numeric_value);
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr);
-      return result;
-    case DOUBLE:
-      result->numeric_value = cos(astr->numeric_value);
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_COS]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+ast_result ast_result_pow_dd(ast_result astr1, ast_result astr2) {
+  return double_ast_result(pow(astr1.value.double_value,
+        astr2.value.double_value));
 }
 
 /**
- * This function takes the arc_cos of astr.
- * @param    astr - The ast result to take the arc_cos of.
- * @return result - The resulf of the arc_cos.
+ * This function compares two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is equal, 0 otherwise.
  */
-ast_result * ast_result_arc_cos(ast_result * astr) {
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr->type) {
-    case INT:
-      result->numeric_value = acos(astr->numeric_value);
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr);
-      return result;
-    case DOUBLE:
-      result->numeric_value = acos(astr->numeric_value);
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_ARC_COS]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+ast_result ast_result_eq_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.int_value == astr2.value.int_value);
 }
 
 /**
- * This function takes the tan of astr.
- * @param    astr - The ast result to take the tan of.
- * @return result - The resulf of the tan.
+ * This function compares two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is equal, 0 otherwise.
  */
-ast_result * ast_result_tan(ast_result * astr) {
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr->type) {
-    case INT:
-      result->numeric_value = tan(astr->numeric_value);
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr);
-      return result;
-    case DOUBLE:
-      result->numeric_value = tan(astr->numeric_value);
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_TAN]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+ast_result ast_result_eq_dd(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.double_value
+      == astr2.value.double_value);
 }
 
 /**
- * This function takes the arc_tan of astr.
- * @param    astr - The ast result to take the arc_tan of.
- * @return result - The resulf of the arc_tan.
+ * This function compares two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is greater or equal, 0 otherwise.
  */
-ast_result * ast_result_arc_tan(ast_result * astr) {
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr->type) {
-    case INT:
-      result->numeric_value = atan(astr->numeric_value);
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr);
-      return result;
-    case DOUBLE:
-      result->numeric_value = atan(astr->numeric_value);
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_TAN]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+ast_result ast_result_gteq_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.int_value >= astr2.value.int_value);
 }
 
 /**
- * This function takes the base 2 logarithm of astr.
- * @param    astr - The ast result to take the logarithm of.
- * @return result - The resulf of the logarithm.
+ * This function compares two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is greater or equal, 0 otherwise.
  */
-ast_result * ast_result_log(ast_result * astr) {
-  ast_result * result = calloc(1, sizeof(struct AST_RESULT_T));
-  switch(astr->type) {
-    case INT:
-      result->numeric_value = log(astr->numeric_value);
-      result->literal = calloc(qty_digits(result->numeric_value) + 1, sizeof(char));
-      sprintf(result->literal, "%d", (int)result->numeric_value);
-      result->type = INT;
-      free_ast_result(astr);
-      return result;
-    case DOUBLE:
-      result->numeric_value = log(astr->numeric_value);
-      // If negative string has one more space, '-'
-      result->literal = (result->numeric_value > 0)
-        ? calloc(10 + qty_digits(result->numeric_value), sizeof(char))
-        : calloc(11 + qty_digits(result->numeric_value), sizeof(char));
-      sprintf(result->literal, "%.8f", result->numeric_value);
-      result->type = DOUBLE;
-      free_ast_result(astr);
-      return result;
-    case STRING:
-      fprintf(stderr, "[AST_RESULT_TAN]: Division not Implemented for"
-          " Strings\nExiting\n");
-      exit(1);
-  }
-  return NULL;
+ast_result ast_result_gteq_dd(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.double_value
+      >= astr2.value.double_value);
+}
+
+/**
+ * This function compares two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is greater, 0 otherwise.
+ */
+ast_result ast_result_gt_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.int_value > astr2.value.int_value);
+}
+
+/**
+ * This function compares two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is greater, 0 otherwise.
+ */
+ast_result ast_result_gt_dd(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.double_value
+      > astr2.value.double_value);
+}
+
+/**
+ * This function compares two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is less or equal, 0 otherwise.
+ */
+ast_result ast_result_lteq_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.int_value <= astr2.value.int_value);
+}
+
+/**
+ * This function compares two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is less or equal, 0 otherwise.
+ */
+ast_result ast_result_lteq_dd(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.double_value
+      <= astr2.value.double_value);
+}
+
+/**
+ * This function compares two INT operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is less, 0 otherwise.
+ */
+ast_result ast_result_lt_ii(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.int_value < astr2.value.int_value);
+}
+
+/**
+ * This function compares two DOUBLE operands (whose types are known).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is less, 0 otherwise.
+ */
+ast_result ast_result_lt_dd(ast_result astr1, ast_result astr2) {
+  return int_ast_result(astr1.value.double_value
+      < astr2.value.double_value);
+}
+
+/**
+ * This function adds an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The sum.
+ */
+ast_result ast_result_add_id(ast_result astr1, ast_result astr2) {
+  return ast_result_add_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function adds a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The sum.
+ */
+ast_result ast_result_add_di(ast_result astr1, ast_result astr2) {
+  return ast_result_add_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function subtracts an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The difference.
+ */
+ast_result ast_result_sub_id(ast_result astr1, ast_result astr2) {
+  return ast_result_sub_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function subtracts a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The difference.
+ */
+ast_result ast_result_sub_di(ast_result astr1, ast_result astr2) {
+  return ast_result_sub_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function multiplies an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The product.
+ */
+ast_result ast_result_mul_id(ast_result astr1, ast_result astr2) {
+  return ast_result_mul_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function multiplies a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The product.
+ */
+ast_result ast_result_mul_di(ast_result astr1, ast_result astr2) {
+  return ast_result_mul_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function divides an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The quotient.
+ */
+ast_result ast_result_div_id(ast_result astr1, ast_result astr2) {
+  return ast_result_div_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function divides a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The quotient.
+ */
+ast_result ast_result_div_di(ast_result astr1, ast_result astr2) {
+  return ast_result_div_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function raises an INT to a DOUBLE power (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The power.
+ */
+ast_result ast_result_pow_id(ast_result astr1, ast_result astr2) {
+  return ast_result_pow_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function raises a DOUBLE to an INT power (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The power.
+ */
+ast_result ast_result_pow_di(ast_result astr1, ast_result astr2) {
+  return ast_result_pow_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function compares an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is equal, 0 otherwise.
+ */
+ast_result ast_result_eq_id(ast_result astr1, ast_result astr2) {
+  return ast_result_eq_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function compares a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is equal, 0 otherwise.
+ */
+ast_result ast_result_eq_di(ast_result astr1, ast_result astr2) {
+  return ast_result_eq_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function compares an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is greater or equal, 0 otherwise.
+ */
+ast_result ast_result_gteq_id(ast_result astr1, ast_result astr2) {
+  return ast_result_gteq_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function compares a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is greater or equal, 0 otherwise.
+ */
+ast_result ast_result_gteq_di(ast_result astr1, ast_result astr2) {
+  return ast_result_gteq_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function compares an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is greater, 0 otherwise.
+ */
+ast_result ast_result_gt_id(ast_result astr1, ast_result astr2) {
+  return ast_result_gt_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function compares a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is greater, 0 otherwise.
+ */
+ast_result ast_result_gt_di(ast_result astr1, ast_result astr2) {
+  return ast_result_gt_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function compares an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is less or equal, 0 otherwise.
+ */
+ast_result ast_result_lteq_id(ast_result astr1, ast_result astr2) {
+  return ast_result_lteq_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function compares a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is less or equal, 0 otherwise.
+ */
+ast_result ast_result_lteq_di(ast_result astr1, ast_result astr2) {
+  return ast_result_lteq_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function compares an INT and a DOUBLE (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is less, 0 otherwise.
+ */
+ast_result ast_result_lt_id(ast_result astr1, ast_result astr2) {
+  return ast_result_lt_dd(promote_ast_result(astr1), astr2);
+}
+
+/**
+ * This function compares a DOUBLE and an INT (the INT is promoted).
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The INT 1 if the left is less, 0 otherwise.
+ */
+ast_result ast_result_lt_di(ast_result astr1, ast_result astr2) {
+  return ast_result_lt_dd(astr1, promote_ast_result(astr2));
+}
+
+/**
+ * This function concatenates two STRINGs.
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - The concatenation.
+ */
+ast_result ast_result_add_ss(ast_result astr1, ast_result astr2) {
+  return string_ast_result(shared_string_concat(astr1.value.string_value,
+        astr2.value.string_value));
+}
+
+/**
+ * This function compares two STRINGs.
+ * @param astr1 - The left hand side.
+ * @param astr2 - The right hand side.
+ * @return   .\ - INT 1 if they are equal, 0 otherwise.
+ */
+ast_result ast_result_eq_ss(ast_result astr1, ast_result astr2) {
+  ast_result result = int_ast_result(shared_string_equals(
+        astr1.value.string_value, astr2.value.string_value));
+  free_ast_result(astr1);
+  free_ast_result(astr2);
+  return result;
+}
+
+/**
+ * This function takes the sine of an INT (truncated to an INT).
+ * @param astr - The operand.
+ * @return  .\ - The sine.
+ */
+ast_result ast_result_sin_i(ast_result astr) {
+  return int_ast_result(double_to_int(sin(astr.value.int_value)));
+}
+
+/**
+ * This function takes the sine of a DOUBLE.
+ * @param astr - The operand.
+ * @return  .\ - The sine.
+ */
+ast_result ast_result_sin_d(ast_result astr) {
+  return double_ast_result(sin(astr.value.double_value));
+}
+
+/**
+ * This function takes the arc sine of an INT (truncated to an INT).
+ * @param astr - The operand.
+ * @return  .\ - The arc sine.
+ */
+ast_result ast_result_arc_sin_i(ast_result astr) {
+  return int_ast_result(double_to_int(asin(astr.value.int_value)));
+}
+
+/**
+ * This function takes the arc sine of a DOUBLE.
+ * @param astr - The operand.
+ * @return  .\ - The arc sine.
+ */
+ast_result ast_result_arc_sin_d(ast_result astr) {
+  return double_ast_result(asin(astr.value.double_value));
+}
+
+/**
+ * This function takes the cosine of an INT (truncated to an INT).
+ * @param astr - The operand.
+ * @return  .\ - The cosine.
+ */
+ast_result ast_result_cos_i(ast_result astr) {
+  return int_ast_result(double_to_int(cos(astr.value.int_value)));
+}
+
+/**
+ * This function takes the cosine of a DOUBLE.
+ * @param astr - The operand.
+ * @return  .\ - The cosine.
+ */
+ast_result ast_result_cos_d(ast_result astr) {
+  return double_ast_result(cos(astr.value.double_value));
+}
+
+/**
+ * This function takes the arc cosine of an INT (truncated to an INT).
+ * @param astr - The operand.
+ * @return  .\ - The arc cosine.
+ */
+ast_result ast_result_arc_cos_i(ast_result astr) {
+  return int_ast_result(double_to_int(acos(astr.value.int_value)));
+}
+
+/**
+ * This function takes the arc cosine of a DOUBLE.
+ * @param astr - The operand.
+ * @return  .\ - The arc cosine.
+ */
+ast_result ast_result_arc_cos_d(ast_result astr) {
+  return double_ast_result(acos(astr.value.double_value));
 }
 
 /**
- * This function determines the number of whole number digits in a number.
- * @param   n - The number to get the property of.
- * @return .\ - How may whole number digits in n.
+ * This function takes the tangent of an INT (truncated to an INT).
+ * @param astr - The operand.
+ * @return  .\ - The tangent.
  */
-int qty_digits(int n) {
-  if (n < 10)         return 1;
-  if (n < 100)        return 2;
-  if (n < 1000)       return 3;
-  if (n < 10000)      return 4;
-  if (n < 100000)     return 5;
-  if (n < 1000000)    return 6;
-  if (n < 10000000)   return 7;
-  if (n < 100000000)  return 8;
-  if (n < 1000000000) return 9;
-  return -1;
+ast_result ast_result_tan_i(ast_result astr) {
+  return int_ast_result(double_to_int(tan(astr.value.int_value)));
 }
 
 /**
- * This function frees an ast_result.
+ * This function takes the tangent of a DOUBLE.
+ * @param astr - The operand.
+ * @return  .\ - The tangent.
+ */
+ast_result ast_result_tan_d(ast_result astr) {
+  return double_ast_result(tan(astr.value.double_value));
+}
+
+/**
+ * This function takes the arc tangent of an INT (truncated to an INT).
+ * @param astr - The operand.
+ * @return  .\ - The arc tangent.
+ */
+ast_result ast_result_arc_tan_i(ast_result astr) {
+  return int_ast_result(double_to_int(atan(astr.value.int_value)));
+}
+
+/**
+ * This function takes the arc tangent of a DOUBLE.
+ * @param astr - The operand.
+ * @return  .\ - The arc tangent.
+ */
+ast_result ast_result_arc_tan_d(ast_result astr) {
+  return double_ast_result(atan(astr.value.double_value));
+}
+
+/**
+ * This function takes the natural logarithm of an INT (truncated to an INT).
+ * @param astr - The operand.
+ * @return  .\ - The natural logarithm.
+ */
+ast_result ast_result_log_i(ast_result astr) {
+  return int_ast_result(double_to_int(log(astr.value.int_value)));
+}
+
+/**
+ * This function takes the natural logarithm of a DOUBLE.
+ * @param astr - The operand.
+ * @return  .\ - The natural logarithm.
+ */
+ast_result ast_result_log_d(ast_result astr) {
+  return double_ast_result(log(astr.value.double_value));
+}
+
+/**
+ * This function drops the reference an ast_result holds to its string (the
+ * only part of an ast_result that lives on the heap).
  * @param astr - The ast_result to be freed.
  * @return N/a
  */
-void free_ast_result(ast_result * astr) {
-  if(astr) {
-    if(astr->literal)
-      free(astr->literal);
-    free(astr);
-  }
+void free_ast_result(ast_result astr) {
+  if(astr.type == STRING)
+    release_shared_string(astr.value.string_value);
 }
@@ -0,0 +1,180 @@
+/**
+ * @file   flat_ast.c
+ * @brief  This file contains the functions relating to the flat_ast data
+ * structure, the post order structure of arrays form of an abstract syntax
+ * tree.
+ * @author Matthew C. Lindeman
+ * @date   September 25, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/flat_ast.h"
+
+/**
+ * This function flattens an abstract syntax tree.
+ * @param abstree - The abstract syntax tree to be flattened.
+ * @param       a - The arena the flat_ast is allocated from.
+ * @return     fa - The flat_ast (released with the arena).
+ */
+flat_ast * flatten_tree(ast * abstree, arena * a) {
+  int qty_nodes = ast_count_nodes(abstree);
+  flat_ast * fa = arena_alloc(a, sizeof(struct FLAT_AST_T));
+  fa->types = arena_alloc(a, qty_nodes * sizeof(token_type));
+  fa->payloads = arena_alloc(a, qty_nodes * sizeof(union FLAT_PAYLOAD_T));
+  fa->lhs = arena_alloc(a, qty_nodes * sizeof(int));
+  fa->rhs = arena_alloc(a, qty_nodes * sizeof(int));
+  fa->kernels = arena_alloc(a, qty_nodes * sizeof(ast_result_kernel));
+  fa->value_types = arena_alloc(a, qty_nodes * sizeof(var_type));
+  fa->qty_nodes = 0;
+  flatten_node(fa, abstree);
+  return fa;
+}
+
+/**
+ * This function appends a node to a flat_ast after its children.
+ * @param      fa - The flat_ast being built.
+ * @param abstree - The node to be appended.
+ * @return      i - The index of the node.
+ */
+int flatten_node(flat_ast * fa, ast * abstree) {
+  int lhs = -1;
+  int rhs = -1;
+  int i = 0;
+  if(abstree->no_children > 2) {
+    fprintf(stderr, "[FLATTEN_NODE]: Unhandled Token: `%s`\nExiting\n",
+        token_type_to_string(abstree->value.type));
+    exit(1);
+  }
+  if(abstree->value.type == TOKEN_ASSIGN) {
+    rhs = flatten_node(fa, abstree->children[1]);
+  } else {
+    if(abstree->no_children > 0)
+      lhs = flatten_node(fa, abstree->children[0]);
+    if(abstree->no_children > 1)
+      rhs = flatten_node(fa, abstree->children[1]);
+  }
+  i = fa->qty_nodes++;
+  fa->types[i] = abstree->value.type;
+  fa->lhs[i] = lhs;
+  fa->rhs[i] = rhs;
+  fa->kernels[i] = abstree->kernel;
+  fa->value_types[i] = abstree->type;
+  switch(abstree->value.type) {
+    case TOKEN_INT:
+      fa->payloads[i].int_value = abstree->value.value.int_value;
+      break;
+    case TOKEN_DOUBLE:
+      fa->payloads[i].double_value = abstree->value.value.double_value;
+      break;
+    case TOKEN_ASSIGN:
+      fa->payloads[i].name.literal = abstree->children[0]->value.t_literal;
+      fa->payloads[i].name.len = abstree->children[0]->value.len;
+      fa->payloads[i].name.atom = abstree->children[0]->value.type == TOKEN_VAR
+        ? abstree->children[0]->value.value.atom_value : NULL;
+      fa->payloads[i].name.slot = abstree->slot;
+      break;
+    default:
+      fa->payloads[i].name.literal = abstree->value.t_literal;
+      fa->payloads[i].name.len = abstree->value.len;
+      fa->payloads[i].name.atom = abstree->value.type == TOKEN_VAR
+        ? abstree->value.value.atom_value : NULL;
+      fa->payloads[i].name.slot = abstree->slot;
+      break;
+  }
+  return i;
+}
+
+/**
+ * This function evaluates a flat_ast in a single front to back pass.  The
+ * value of every node is kept at its own index and is consumed by its parent.
+ * @param fa - The flat_ast to be evaluated.
+ * @param  a - The arena the values are allocated from.
+ * @param st - The stack frame for the evaluated tree.
+ * @return .\ - The result of the evaluation (the value of the last node).
+ */
+ast_result evaluate_flat_ast(flat_ast * fa, arena * a, symbol_table ** st) {
+  ast_result * values = arena_alloc(a, fa->qty_nodes
+      * sizeof(struct AST_RESULT_T));
+  flat_payload * p = NULL;
+  int variable_index = 0;
+  for(int i = 0; i < fa->qty_nodes; i++) {
+    p = &fa->payloads[i];
+    switch(fa->types[i]) {
+      case TOKEN_VAR:
+        variable_index = p->name.slot != -1 ? p->name.slot
+          : find_variable_atom(st[0], p->name.atom);
+        if(variable_index == -1 || !st[0]->udv[variable_index]->is_set) {
+          fprintf(stderr, "[EVALUATE_FLAT_AST]: Variable `%.*s` not found.\n"
+              "Exiting\n", (int)p->name.len, p->name.literal);
+          exit(1);
+        }
+        values[i] = init_ast_result_from_variable(st[0]->udv[variable_index]);
+        break;
+      case TOKEN_INT:
+        values[i] = int_ast_result(p->int_value);
+        break;
+      case TOKEN_DOUBLE:
+        values[i] = double_ast_result(p->double_value);
+        break;
+      case TOKEN_STRING:
+        values[i] = init_ast_result(p->name.literal, p->name.len, STRING);
+        break;
+      case TOKEN_ASSIGN:
+        if(p->name.slot == -1 && !p->name.atom) {
+          fprintf(stderr, "[EVALUATE_FLAT_AST]: Cannot assign to `%.*s`\n"
+              "Exiting\n", (int)p->name.len, p->name.literal);
+          exit(1);
+        }
+        values[i] = p->name.slot != -1
+          ? ast_result_assign_slot(p->name.slot, values[fa->rhs[i]], st)
+          : ast_result_assign(p->name.atom, values[fa->rhs[i]], st);
+        break;
+      default:
+        if(binary_op_of(fa->types[i]) != QTY_BINARY_OPS) {
+          values[i] = ast_result_binary(binary_op_of(fa->types[i]),
+              values[fa->lhs[i]], values[fa->rhs[i]]);
+          break;
+        }
+        if(unary_op_of(fa->types[i]) != QTY_UNARY_OPS) {
+          values[i] = ast_result_unary(unary_op_of(fa->types[i]),
+              values[fa->lhs[i]]);
+          break;
+        }
+        fprintf(stderr, "[EVALUATE_FLAT_AST]: Unhandled Token: `%s`\n"
+            "Exiting\n", token_type_to_string(fa->types[i]));
+        exit(1);
+    }
+  }
+  return values[fa->qty_nodes - 1];
+}
+
+/**
+ * This function is used for debugging flat_asts.
+ * @param fa - The flat_ast to be debugged.
+ * @return N/a
+ */
+void flat_ast_dump_debug(flat_ast * fa) {
+  printf("Flat AST\n");
+  for(int i = 0; i < fa->qty_nodes; i++) {
+    printf("%04d %-14s %4d %4d", i, token_type_to_string(fa->types[i]),
+        fa->lhs[i], fa->rhs[i]);
+    switch(fa->types[i]) {
+      case TOKEN_INT:
+        printf(" %lld", fa->payloads[i].int_value);
+        break;
+      case TOKEN_DOUBLE:
+        printf(" %f", fa->payloads[i].double_value);
+        break;
+      case TOKEN_VAR:
+      case TOKEN_STRING:
+      case TOKEN_ASSIGN:
+        printf(" `%.*s`", (int)fa->payloads[i].name.len,
+            fa->payloads[i].name.literal);
+        break;
+      default:
+        break;
+    }
+    printf("\n");
+  }
+  printf("--\n");
+}
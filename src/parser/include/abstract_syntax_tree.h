@@ -11,28 +11,43 @@
 #define AST_H
 
 #include "ast_result.h"
-#include "../../token/include/token_stack.h"
+#include "../../token/include/token_buffer.h"
+#include "../../arena/include/arena.h"
 
 /**
  * This data structure is used to represent functions. It is a standard abstract
  * syntax tree with only double values (as we are dealing with funcitons). There
- * are no explicit nodes.
+ * are no explicit nodes.  Trees are allocated from an arena and are released
+ * all at once when the arena is reset.
  */
 typedef struct AST_T {
   /** The token representing the value */
-  token * value;
+  token value;
   /** The children of the current node */
   struct AST_T ** children;
-  /** The numeric value of the current node */
-  double numeric_value;
   /** The number of children of the current node */
   int no_children;
+  /** The frame slot of a TOKEN_VAR/TOKEN_ASSIGN node (-1 until resolved) */
+  int slot;
+  /** The type of the value of the node (if is_typed) */
+  var_type type;
+  /** Whether the type of the node is known before it runs (set by
+   * type_check_tree) */
+  int is_typed;
+  /** The kernel of a binary operator whose operand types are known (NULL
+   * otherwise) */
+  ast_result_kernel kernel;
 } ast;
 
-ast * init_ast(char * t_literal, token_type type);
+ast * init_ast(arena * a, const char * t_literal, token_type type);
+ast * init_ast_from_token(arena * a, token t);
 void ast_dump_debug(ast * abstree);
-ast_result * evaluate_tree(ast * abstree, symbol_table ** st);
-ast * add_child(ast * parent, ast * new_child);
-void free_ast(ast * abstree);
+ast_result evaluate_tree(ast * abstree, symbol_table ** st);
+int ast_count_nodes(ast * abstree);
+void resolve_tree(ast * abstree, symbol_table * layout);
+ast_result evaluate_variable(ast * abstree, symbol_table ** st);
+binary_op binary_op_of(token_type type);
+unary_op unary_op_of(token_type type);
+ast * add_child(arena * a, ast * parent, ast * new_child);
 
 #endif
@@ -10,49 +10,155 @@
 #define ASTR_H
 
 #include <math.h>
+#include <limits.h>
+#include <stdio.h>
 #include <string.h>
-#include "../../main/include/constants.h"
 #include "../../symbol_table/include/var_type.h"
 #include "../../symbol_table/include/symbol_table.h"
 
 /**
  * This structure is used for wrapping the result of the evaluate_tree function.
- * The reason for its existance is that you cannot return both type encoding and
- * the literal value at the same time without modifying data on the heap. This
- * seems like a less bug prone alternative.
+ * It is a small tagged value that is passed around by value, a STRING result
+ * owns a reference to a shared_string.  Numbers are only turned into text
+ * when they are printed.
  */
 typedef struct AST_RESULT_T {
-  /** The literal value of the result of the evaluated ast */
-  char * literal;
-  /** The numeric value of the result of the evaluated ast */
-  double numeric_value;
+  /** The value of the result (which member is live depends on type) */
+  union {
+    /** The value of an INT result */
+    long long int_value;
+    /** The value of a DOUBLE result */
+    double double_value;
+    /** The value of a STRING result */
+    shared_string * string_value;
+  } value;
   /** The variable type of the result of the evaluated ast */
   var_type type;
 } ast_result;
 
-ast_result * init_ast_result(char * literal, var_type type);
-void ast_result_dump_debug(ast_result * astr);
-void ast_print_result(ast_result * astr);
-ast_result * ast_result_addition(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_subtraction(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_multiplication(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_division(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_power(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_assign(char * var, ast_result * value,
+/**
+ * The binary operators, the first index of BINARY_KERNELS.
+ */
+typedef enum {
+  BINARY_ADD,
+  BINARY_SUB,
+  BINARY_MUL,
+  BINARY_DIV,
+  BINARY_POW,
+  /** The comparisons (from here on) have INT values */
+  BINARY_EQ,
+  BINARY_GT_EQ,
+  BINARY_GT,
+  BINARY_LT_EQ,
+  BINARY_LT,
+  QTY_BINARY_OPS
+} binary_op;
+
+/**
+ * The functions, the first index of UNARY_KERNELS.
+ */
+typedef enum {
+  UNARY_SIN,
+  UNARY_ARC_SIN,
+  UNARY_COS,
+  UNARY_ARC_COS,
+  UNARY_TAN,
+  UNARY_ARC_TAN,
+  UNARY_LOG,
+  QTY_UNARY_OPS
+} unary_op;
+
+/** A binary operator on operands of given types (no checks) */
+typedef ast_result (*ast_result_kernel)(ast_result astr1, ast_result astr2);
+/** A function on an operand of a given type (no checks) */
+typedef ast_result (*ast_result_unary_kernel)(ast_result astr);
+
+extern const ast_result_kernel BINARY_KERNELS[QTY_BINARY_OPS][QTY_VAR_TYPES]
+    [QTY_VAR_TYPES];
+extern const ast_result_unary_kernel UNARY_KERNELS[QTY_UNARY_OPS]
+    [QTY_VAR_TYPES];
+
+ast_result init_ast_result(const char * literal, size_t len, var_type type);
+ast_result int_ast_result(long long value);
+ast_result double_ast_result(double value);
+long long int_add(long long lhs, long long rhs);
+long long int_sub(long long lhs, long long rhs);
+long long int_mul(long long lhs, long long rhs);
+long long int_div(long long lhs, long long rhs);
+long long double_to_int(double value);
+ast_result string_ast_result(shared_string * value);
+ast_result init_ast_result_from_variable(variable * var);
+ast_result copy_ast_result(ast_result astr);
+int ast_result_format(ast_result astr, char * buf, size_t size);
+void ast_result_dump_debug(ast_result astr);
+void ast_print_result(ast_result astr);
+ast_result ast_result_assign(const atom * var, ast_result value,
+    symbol_table ** st);
+ast_result ast_result_assign_slot(int slot, ast_result value,
     symbol_table ** st);
-ast_result * ast_result_equality(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_gteq(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_gt(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_lteq(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_lt(ast_result * astr1, ast_result * astr2);
-ast_result * ast_result_sin(ast_result * astr);
-ast_result * ast_result_arc_sin(ast_result * astr);
-ast_result * ast_result_cos(ast_result * astr);
-ast_result * ast_result_arc_cos(ast_result * astr);
-ast_result * ast_result_tan(ast_result * astr);
-ast_result * ast_result_arc_tan(ast_result * astr);
-ast_result * ast_result_log(ast_result * astr);
-int qty_digits(int n);
-void free_ast_result(ast_result * astr);
+ast_result ast_result_binary(binary_op op, ast_result astr1,
+    ast_result astr2);
+ast_result ast_result_unary(unary_op op, ast_result astr);
+var_type binary_result_type(binary_op op, var_type lhs, var_type rhs);
+ast_result promote_ast_result(ast_result astr);
+const char * binary_op_to_string(binary_op op);
+const char * unary_op_to_string(unary_op op);
+ast_result ast_result_add_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_add_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_add_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_add_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_sub_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_sub_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_sub_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_sub_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_mul_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_mul_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_mul_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_mul_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_div_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_div_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_div_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_div_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_pow_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_pow_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_pow_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_pow_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_eq_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_eq_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_eq_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_eq_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_gteq_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_gteq_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_gteq_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_gteq_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_gt_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_gt_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_gt_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_gt_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_lteq_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_lteq_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_lteq_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_lteq_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_lt_ii(ast_result astr1, ast_result astr2);
+ast_result ast_result_lt_id(ast_result astr1, ast_result astr2);
+ast_result ast_result_lt_di(ast_result astr1, ast_result astr2);
+ast_result ast_result_lt_dd(ast_result astr1, ast_result astr2);
+ast_result ast_result_add_ss(ast_result astr1, ast_result astr2);
+ast_result ast_result_eq_ss(ast_result astr1, ast_result astr2);
+ast_result ast_result_sin_i(ast_result astr);
+ast_result ast_result_sin_d(ast_result astr);
+ast_result ast_result_arc_sin_i(ast_result astr);
+ast_result ast_result_arc_sin_d(ast_result astr);
+ast_result ast_result_cos_i(ast_result astr);
+ast_result ast_result_cos_d(ast_result astr);
+ast_result ast_result_arc_cos_i(ast_result astr);
+ast_result ast_result_arc_cos_d(ast_result astr);
+ast_result ast_result_tan_i(ast_result astr);
+ast_result ast_result_tan_d(ast_result astr);
+ast_result ast_result_arc_tan_i(ast_result astr);
+ast_result ast_result_arc_tan_d(ast_result astr);
+ast_result ast_result_log_i(ast_result astr);
+ast_result ast_result_log_d(ast_result astr);
+void free_ast_result(ast_result astr);
 
 #endif
@@ -0,0 +1,66 @@
+/**
+ * @file   flat_ast.h
+ * @brief  This file contains the function definitions for flat_ast.c
+ * @author Matthew C. Lindeman
+ * @date   September 25, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef FAST_H
+#define FAST_H
+
+#include "abstract_syntax_tree.h"
+
+/**
+ * This union is the payload of a node of a flat_ast.
+ */
+typedef union FLAT_PAYLOAD_T {
+  /** The value of a TOKEN_INT node */
+  long long int_value;
+  /** The value of a TOKEN_DOUBLE node */
+  double double_value;
+  /** The literal of a TOKEN_VAR/TOKEN_STRING node (or the target of a
+   * TOKEN_ASSIGN node) */
+  struct {
+    /** The literal (not NUL terminated) */
+    const char * literal;
+    /** The length of the literal */
+    size_t len;
+    /** The atom of the variable (NULL for a TOKEN_STRING node) */
+    const atom * atom;
+    /** The frame slot of the variable (-1 if unresolved) */
+    int slot;
+  } name;
+} flat_payload;
+
+/**
+ * This structure is an abstract syntax tree stored as parallel arrays in post
+ * order (structure of arrays).  Children always come before their parent, so
+ * a tree is evaluated by walking the arrays front to back, and it holds no
+ * pointers between nodes so it can be copied or written out as is.  The target
+ * of an assignment is kept in the payload of the assignment rather than as a
+ * node of its own.
+ */
+typedef struct FLAT_AST_T {
+  /** The type of every node */
+  token_type * types;
+  /** The payload of every node */
+  flat_payload * payloads;
+  /** The index of the left (or only) child of every node, -1 if none */
+  int * lhs;
+  /** The index of the right child of every node, -1 if none */
+  int * rhs;
+  /** The kernel the type checker gave every node (NULL if none) */
+  ast_result_kernel * kernels;
+  /** The type of the value of every node (if the type checker found it) */
+  var_type * value_types;
+  /** The number of nodes */
+  int qty_nodes;
+} flat_ast;
+
+flat_ast * flatten_tree(ast * abstree, arena * a);
+int flatten_node(flat_ast * fa, ast * abstree);
+ast_result evaluate_flat_ast(flat_ast * fa, arena * a, symbol_table ** st);
+void flat_ast_dump_debug(flat_ast * fa);
+
+#endif
@@ -12,11 +12,33 @@
 #include <math.h>
 #include "abstract_syntax_tree.h"
 
-ast * parse_expression(token_stack ** ts, symbol_table ** st);
-ast * parse_term(token_stack ** ts, symbol_table ** st);
-ast * parse_factor(token_stack ** ts, symbol_table ** st);
-ast * binary_tree(ast * parent, ast * left_child, ast * right_child);
-ast * unary_tree(ast * parent, ast * child);
-ast * simplify_tree(ast * abstree);
+/**
+ * This structure describes how an operator token is parsed.
+ */
+typedef struct OPERATOR_INFO_T {
+  /** The literal of the node the operator produces */
+  const char * literal;
+  /** The binding power of the operator (0 if it is not an operator) */
+  int precedence;
+  /** Whether the operator is right associative */
+  int right_assoc;
+  /** Whether the operator is a prefix function rather than a binary one */
+  int is_prefix;
+} operator_info;
+
+extern const operator_info OPERATOR_TABLE[TOKEN_NEWLINE + 1];
+
+ast * parse_expression(token_buffer * tb, arena * a);
+ast * parse_binary(token_buffer * tb, arena * a, int min_precedence);
+ast * parse_factor(token_buffer * tb, arena * a);
+ast * binary_tree(arena * a, ast * parent, ast * left_child,
+    ast * right_child);
+ast * unary_tree(arena * a, ast * parent, ast * child);
+ast * simplify_tree(arena * a, ast * abstree);
+int is_foldable_tree(ast * abstree);
+int is_numeric_tree(ast * abstree);
+var_type literal_type(ast * abstree);
+int is_int_literal(ast * abstree, long long value);
+ast * fold_tree(arena * a, ast * abstree);
 
 #endif
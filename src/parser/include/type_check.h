@@ -0,0 +1,54 @@
+/**
+ * @file   type_check.h
+ * @brief  This file contains the function definitions for type_check.c
+ * @author Matthew C. Lindeman
+ * @date   October 05, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef TYC_H
+#define TYC_H
+
+#include "abstract_syntax_tree.h"
+
+/** The number of slots a type environment starts with room for */
+#define INITIAL_TYPE_SLOTS 16
+
+/**
+ * This structure is what is known of the variables of a frame layout at a
+ * point of a program: the type each slot holds once the statements before
+ * it have run.
+ */
+typedef struct TYPE_ENV_T {
+  /** The type of the variable in each slot (if is_known) */
+  var_type * types;
+  /** Whether the variable in each slot is known to be set */
+  int * is_known;
+  /** The number of slots there is room for */
+  int cap;
+} type_env;
+
+/**
+ * This structure is a type error found before a program runs.
+ */
+typedef struct TYPE_ERROR_T {
+  /** The operator (or function) the error is on */
+  token op;
+  /** The type of the left hand side (or only) operand */
+  var_type lhs;
+  /** The type of the right hand side operand */
+  var_type rhs;
+  /** Whether the operator is not defined on the type of its operands
+   * (otherwise their types do not match) */
+  int is_unsupported;
+} type_error;
+
+type_env * init_type_env(void);
+void type_env_set(type_env * env, int slot, var_type type);
+void type_env_forget(type_env * env, int slot);
+int type_check_tree(ast * abstree, type_env * env, type_error * err);
+int type_check_operator(ast * abstree, type_error * err);
+void report_type_error(type_error * err, int line_no);
+void free_type_env(type_env * env);
+
+#endif
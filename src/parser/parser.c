@@ -10,222 +10,141 @@
 #include"include/parser.h"
 
 /**
- * This function parses an expression from a token stack. Essentially anything
- * that is a mathematical term (in the sense of operands of +/-).
- * @param  tok_list - the token stack to be parsed
+ * The operator table of the parser, indexed by token type.  A token with a
+ * precedence of 0 is not an operator.  Binary operators bind tighter the
+ * higher their precedence, for prefix operators (the functions) precedence is
+ * how tightly they bind their operand.
+ */
+const operator_info OPERATOR_TABLE[TOKEN_NEWLINE + 1] = {
+  [TOKEN_ASSIGN]   = {"=",      1, 1, 0},
+  [TOKEN_L_OR]     = {"||",     2, 0, 0},
+  [TOKEN_EQUALITY] = {"==",     3, 0, 0},
+  [TOKEN_GT_EQ]    = {">=",     3, 0, 0},
+  [TOKEN_GT]       = {">",      3, 0, 0},
+  [TOKEN_LT_EQ]    = {"<=",     3, 0, 0},
+  [TOKEN_LT]       = {"<",      3, 0, 0},
+  [TOKEN_PLUS]     = {"+",      4, 0, 0},
+  [TOKEN_MINUS]    = {"-",      4, 0, 0},
+  [TOKEN_MULT]     = {"*",      5, 0, 0},
+  [TOKEN_DIV]      = {"/",      5, 0, 0},
+  [TOKEN_POWER]    = {"^",      6, 1, 0},
+  [TOKEN_SIN]      = {"sin",    6, 0, 1},
+  [TOKEN_COS]      = {"cos",    6, 0, 1},
+  [TOKEN_TAN]      = {"tan",    6, 0, 1},
+  [TOKEN_ARC_SIN]  = {"arcsin", 6, 0, 1},
+  [TOKEN_ARC_COS]  = {"arccos", 6, 0, 1},
+  [TOKEN_ARC_TAN]  = {"arctan", 6, 0, 1},
+  [TOKEN_LOG]      = {"log",    6, 0, 1}
+};
+
+/**
+ * This function parses an expression from a token buffer.
+ * @param        tb - the token buffer to be parsed
+ * @param         a - the arena the tree is allocated from
  * @return       .\ - the abstract syntax tree of the expression
  */
-ast * parse_expression(token_stack ** ts, symbol_table ** st) {
-  ast * left_child = NULL;
-  ast * right_child = NULL;
-  if(ts[0]) {
-    left_child = parse_term(ts, st);
-    switch(ts[0]->current->type) {
-      case TOKEN_PLUS:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast("+", TOKEN_PLUS), left_child, right_child);
-      case TOKEN_MINUS:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast("-", TOKEN_MINUS), left_child, right_child);
-      case TOKEN_ASSIGN:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast("=", TOKEN_ASSIGN), left_child, right_child);
-      case TOKEN_EQUALITY:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast("==", TOKEN_EQUALITY), left_child, right_child);
-      case TOKEN_GT_EQ:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast(">=", TOKEN_GT_EQ), left_child, right_child);
-      case TOKEN_GT:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast(">", TOKEN_GT), left_child, right_child);
-      case TOKEN_LT_EQ:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast("<=", TOKEN_LT_EQ), left_child, right_child);
-      case TOKEN_LT:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast("<", TOKEN_LT), left_child, right_child);
-      case TOKEN_L_OR:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_expression(ts, st);
-        return binary_tree(init_ast("||", TOKEN_L_OR), left_child, right_child);
-      case TOKEN_MULT:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_term(ts, st);
-        return binary_tree(init_ast("*", TOKEN_MULT), left_child, right_child);
-      case TOKEN_DIV:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_term(ts, st);
-        return binary_tree(init_ast("/", TOKEN_DIV), left_child, right_child);
-      case TOKEN_L_BRACKET:
-        right_child = parse_factor(ts, st);
-        return unary_tree(left_child, right_child);
-      case TOKEN_R_PAREN:
-      case TOKEN_R_BRACKET:
-      case TOKEN_VAR:
-      case TOKEN_INT:
-      case TOKEN_DOUBLE:
-      case TOKEN_COMMA:
-      case TOKEN_STRING:
-      case TOKEN_NEWLINE: // This will occur bc factor pops id i.e. newline
-        return left_child;
-      default:
-        fprintf(stderr, "[PARSER1]: Unrecognized token: `%s`\nExiting\n",
-            ts[0]->current->t_literal);
-        exit(1);
-    }
-  } else {
-    return left_child;
-  }
+ast * parse_expression(token_buffer * tb, arena * a) {
+  if(!has_token(tb))
+    return NULL;
+  return parse_binary(tb, a, 1);
 }
 
 /**
- * This function parses a term from the token stack.  Essentially just anything
- * that is a mathematical coefficient.
- * @param  ts - the token stack from which the term is read
- * @return .\ - the appropriate abstract syntrax tree to model the input
+ * This function parses a chain of binary operators that bind at least as
+ * tightly as min_precedence (precedence climbing).  Operators of the same
+ * precedence are folded into the tree in a loop, so a left associative chain
+ * of any length only recurses once per precedence level.
+ * @param              tb - the token buffer to be parsed
+ * @param               a - the arena the tree is allocated from
+ * @param  min_precedence - the loosest operator this call may consume
+ * @return           left - the abstract syntax tree of the chain
  */
-ast * parse_term(token_stack ** ts, symbol_table ** st) {
-  ast * left_child = NULL;
-  ast * right_child = NULL;
-  if(ts[0]) {
-    left_child = parse_factor(ts, st);
-    switch(ts[0]->current->type) {
-      case TOKEN_VAR:
-      case TOKEN_INT:
-      case TOKEN_DOUBLE:
-      case TOKEN_STRING:
-        return left_child;
-      case TOKEN_MULT:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_factor(ts, st);
-        return binary_tree(init_ast("*", TOKEN_MULT), left_child, right_child);
-      case TOKEN_DIV:
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_factor(ts, st);
-        return binary_tree(init_ast("/", TOKEN_DIV), left_child, right_child);
-      case TOKEN_PLUS:
-        return left_child;
-        // ts[0] = pop_token(ts[0]);
-        // right_child = parse_factor(ts, st);
-        // return binary_tree(init_ast("+", TOKEN_PLUS), left_child, right_child);
-      case TOKEN_MINUS:
-        return left_child;
-        // ts[0] = pop_token(ts[0]);
-        // right_child = parse_factor(ts, st);
-        // return binary_tree(init_ast("-", TOKEN_MINUS), left_child, right_child);
-      default:
-        return left_child;
+ast * parse_binary(token_buffer * tb, arena * a, int min_precedence) {
+  ast * left = parse_factor(tb, a);
+  ast * right = NULL;
+  const operator_info * op = NULL;
+  token_type type = TOKEN_NEWLINE;
+  while(1) {
+    type = CURRENT_TOKEN(tb).type;
+    op = &OPERATOR_TABLE[type];
+    if(!op->precedence || op->is_prefix) {
+      switch(type) {
+        case TOKEN_L_BRACKET:
+          left = unary_tree(a, left, parse_factor(tb, a));
+          continue;
+        case TOKEN_R_PAREN:
+        case TOKEN_R_BRACKET:
+        case TOKEN_VAR:
+        case TOKEN_INT:
+        case TOKEN_DOUBLE:
+        case TOKEN_COMMA:
+        case TOKEN_STRING:
+        case TOKEN_NEWLINE:
+          return left;
+        default:
+          fprintf(stderr, "[PARSER1]: Unrecognized token: `%.*s`\nExiting\n",
+              (int)CURRENT_TOKEN(tb).len, CURRENT_TOKEN(tb).t_literal);
+          exit(1);
+      }
     }
-  } else {
-    return NULL;
+    if(op->precedence < min_precedence)
+      return left;
+    advance_token(tb);
+    right = parse_binary(tb, a, op->right_assoc ? op->precedence
+        : op->precedence + 1);
+    left = binary_tree(a, init_ast(a, op->literal, type), left, right);
   }
 }
 
 /**
- * This function is meant to parse a factor, just either a number/variable or an
- * expression within a parenthesis
- * @param          ts - the token stack to be parsed
- * @return left_child - the new abstract syntax tree from the factor
+ * This function is meant to parse a factor, just either a number/variable, an
+ * expression within a parenthesis, a list or a function applied to a factor
+ * @param          tb - the token buffer to be parsed
+ * @param           a - the arena the tree is allocated from
+ * @return         .\ - the new abstract syntax tree from the factor
  */
-ast * parse_factor(token_stack ** ts, symbol_table ** st) {
+ast * parse_factor(token_buffer * tb, arena * a) {
   ast * parent = NULL;
-  ast * left_child = NULL;
-  ast * right_child = NULL;
-  switch(ts[0]->current->type) {
+  ast * child = NULL;
+  token_type type = CURRENT_TOKEN(tb).type;
+  switch(type) {
     case TOKEN_VAR:
-      left_child = init_ast(ts[0]->current->t_literal, ts[0]->current->type);
-      ts[0] = pop_token(ts[0]);
-      if(ts[0]->current->type != TOKEN_POWER)
-        return left_child;
-      ts[0] = pop_token(ts[0]);
-      right_child = parse_factor(ts, st);
-      return binary_tree(init_ast("^", TOKEN_POWER), left_child, right_child);
     case TOKEN_STRING:
-      left_child = init_ast(ts[0]->current->t_literal, ts[0]->current->type);
-      ts[0] = pop_token(ts[0]);
-      return left_child;
     case TOKEN_INT:
     case TOKEN_DOUBLE:
-      left_child = init_ast(ts[0]->current->t_literal, ts[0]->current->type);
-      ts[0] = pop_token(ts[0]);
-      if(ts[0]->current->type != TOKEN_POWER)
-        return left_child;
-      ts[0] = pop_token(ts[0]);
-      right_child = parse_factor(ts, st);
-      return binary_tree(init_ast("^", TOKEN_POWER), left_child, right_child);
+      child = init_ast_from_token(a, CURRENT_TOKEN(tb));
+      advance_token(tb);
+      return child;
     case TOKEN_L_PAREN:
-      ts[0] = pop_token(ts[0]);
-      left_child = parse_expression(ts, st);
-      if(ts[0]->current->type == TOKEN_R_PAREN) {
-        ts[0] = pop_token(ts[0]);
-        if(ts[0]->current->type != TOKEN_POWER)
-          return left_child;
-        ts[0] = pop_token(ts[0]);
-        right_child = parse_factor(ts, st);
-        return binary_tree(init_ast("^", TOKEN_POWER), left_child, right_child);
-      } else {
+      advance_token(tb);
+      child = parse_expression(tb, a);
+      if(CURRENT_TOKEN(tb).type != TOKEN_R_PAREN) {
         fprintf(stderr, "[PARSER4]: UnMatched Parenthesis\nExiting\n");
         exit(1);
       }
+      advance_token(tb);
+      return child;
     case TOKEN_L_BRACKET:
-      ts[0] = pop_token(ts[0]);
-      parent = init_ast("[]", TOKEN_L_BRACKET);
-      parent = add_child(parent, parse_expression(ts, st));
-      while(ts[0]->current->type != TOKEN_R_BRACKET) {
-        if(ts[0]->current->type == TOKEN_COMMA)
-          ts[0] = pop_token(ts[0]);
-        parent = add_child(parent, parse_expression(ts, st));
+      advance_token(tb);
+      parent = init_ast(a, "[]", TOKEN_L_BRACKET);
+      parent = add_child(a, parent, parse_expression(tb, a));
+      while(CURRENT_TOKEN(tb).type != TOKEN_R_BRACKET) {
+        if(CURRENT_TOKEN(tb).type == TOKEN_COMMA)
+          advance_token(tb);
+        parent = add_child(a, parent, parse_expression(tb, a));
       }
       ast_dump_debug(parent);
       return parent;
-    case TOKEN_MULT:
-      ts[0] = pop_token(ts[0]);
-      right_child = parse_term(ts, st);
-      return binary_tree(init_ast("*", TOKEN_MULT), left_child, right_child);
-    case TOKEN_DIV:
-      ts[0] = pop_token(ts[0]);
-      right_child = parse_term(ts, st);
-      return binary_tree(init_ast("/", TOKEN_DIV), left_child, right_child);
-    case TOKEN_SIN:
-      ts[0] = pop_token(ts[0]);
-      right_child = parse_factor(ts, st);
-      return unary_tree(init_ast("sin", TOKEN_SIN), right_child);
-    case TOKEN_COS:
-      ts[0] = pop_token(ts[0]);
-      right_child = parse_factor(ts, st);
-      return unary_tree(init_ast("cos", TOKEN_COS), right_child);
-    case TOKEN_TAN:
-      ts[0] = pop_token(ts[0]);
-      right_child = parse_factor(ts, st);
-      return unary_tree(init_ast("tan", TOKEN_TAN), right_child);
-    case TOKEN_ARC_SIN:
-      ts[0] = pop_token(ts[0]); 
-      right_child = parse_factor(ts, st);
-      return unary_tree(init_ast("arcsin", TOKEN_ARC_SIN), right_child);
-    case TOKEN_ARC_COS:
-      ts[0] = pop_token(ts[0]); 
-      right_child = parse_factor(ts, st);
-      return unary_tree(init_ast("arccos", TOKEN_ARC_COS), right_child);
-    case TOKEN_ARC_TAN:
-      ts[0] = pop_token(ts[0]); 
-      right_child = parse_factor(ts, st);
-      return unary_tree(init_ast("arctan", TOKEN_ARC_TAN), right_child);
-    case TOKEN_LOG:
-      ts[0] = pop_token(ts[0]); 
-      right_child = parse_factor(ts, st);
-      return unary_tree(init_ast("log", TOKEN_LOG), right_child);
     default:
-      fprintf(stderr, "[PARSER3]: Unrecognized token: `%s` type: `%s`\nExiting\n",
-          ts[0]->current->t_literal, token_type_to_string(ts[0]->current->type));
+      if(OPERATOR_TABLE[type].is_prefix) {
+        advance_token(tb);
+        child = parse_binary(tb, a, OPERATOR_TABLE[type].precedence);
+        return unary_tree(a, init_ast(a, OPERATOR_TABLE[type].literal, type),
+            child);
+      }
+      fprintf(stderr, "[PARSER3]: Unrecognized token: `%.*s` type: `%s`\n"
+          "Exiting\n", (int)CURRENT_TOKEN(tb).len, CURRENT_TOKEN(tb).t_literal,
+          token_type_to_string(type));
       exit(1);
   }
 }
@@ -233,13 +152,15 @@ ast * parse_factor(token_stack ** ts, symbol_table ** st) {
 /**
  * This function takes a parent tree, allocates space for children, then sets
  * the children to be left and right children respectively
+ * @param           a - the arena the tree is allocated from
  * @param      parent - the parent node of the tree
  * @param  left_child - the left child of the tree
  * @param right_child - the right child of the tree
  * @return     parent - the new tree with children left_child and right_child
  */
-ast * binary_tree(ast * parent, ast * left_child, ast * right_child) {
-  parent->children = calloc(2, sizeof(struct AST_T *));
+ast * binary_tree(arena * a, ast * parent, ast * left_child,
+    ast * right_child) {
+  parent->children = arena_alloc(a, 2 * sizeof(struct AST_T *));
   parent->children[0] = left_child;
   parent->children[1] = right_child;
   parent->no_children = 2;
@@ -248,13 +169,174 @@ ast * binary_tree(ast * parent, ast * left_child, ast * right_child) {
 
 /**
  * This function generates a unary tree with a parent-child relationship
+ * @param       a - the arena the tree is allocated from
  * @param  parent - the parent of the tree
  * @param   child - the child of the tree
  * @return parent - the new tree
  */
-ast * unary_tree(ast * parent, ast * child) {
-  parent->children = calloc(1, sizeof(struct AST_T *));
+ast * unary_tree(arena * a, ast * parent, ast * child) {
+  parent->children = arena_alloc(a, sizeof(struct AST_T *));
   parent->children[0] = child;
   parent->no_children = 1;
   return parent;
 }
+
+/**
+ * This function simplifies a tree in place (children first).  Subtrees made
+ * only of literals are folded into a single literal and the identities x * 1,
+ * 1 * x, x + 0, 0 + x, x ^ 1 and x ^ 2 (for a variable x, becomes x * x) are
+ * applied.  The identities only match INT literals and only fire for an x the
+ * type checker found numeric (so `s * 1` still stops the program for a STRING
+ * s): they keep the type of x (an INT literal is promoted for a DOUBLE x,
+ * though x + 0 then keeps a -0.0 that the sum would have made 0.0).  A tree
+ * that has not been type checked is only folded.
+ * @param       a - the arena the tree is allocated from
+ * @param abstree - the tree to be simplified
+ * @return     .\ - the simplified tree
+ */
+ast * simplify_tree(arena * a, ast * abstree) {
+  ast ** children = abstree->children;
+  ast * square = NULL;
+  for(int i = 0; i < abstree->no_children; i++)
+    children[i] = simplify_tree(a, children[i]);
+  if(is_foldable_tree(abstree))
+    return fold_tree(a, abstree);
+  switch(abstree->value.type) {
+    case TOKEN_MULT:
+      if(is_int_literal(children[1], 1) && is_numeric_tree(children[0]))
+        return children[0];
+      if(is_int_literal(children[0], 1) && is_numeric_tree(children[1]))
+        return children[1];
+      return abstree;
+    case TOKEN_PLUS:
+      if(is_int_literal(children[1], 0) && is_numeric_tree(children[0]))
+        return children[0];
+      if(is_int_literal(children[0], 0) && is_numeric_tree(children[1]))
+        return children[1];
+      return abstree;
+    case TOKEN_POWER:
+      if(!is_numeric_tree(children[0]))
+        return abstree;
+      if(is_int_literal(children[1], 1))
+        return children[0];
+      if(is_int_literal(children[1], 2) && children[0]->value.type == TOKEN_VAR)
+      {
+        square = binary_tree(a, init_ast(a, "*", TOKEN_MULT), children[0],
+            children[0]);
+        // x * x has the type (and the kernel) of x ^ 2
+        square->type = abstree->type;
+        square->is_typed = 1;
+        square->kernel = BINARY_KERNELS[BINARY_MUL][children[0]->type]
+          [children[0]->type];
+        return square;
+      }
+      return abstree;
+    default:
+      return abstree;
+  }
+}
+
+/**
+ * This function determines whether the type checker found the value of a
+ * node to be a number.
+ * @param abstree - the node to be checked
+ * @return     .\ - 1 if it is an INT or a DOUBLE, 0 if it is a STRING or not
+ *                  known
+ */
+int is_numeric_tree(ast * abstree) {
+  return abstree->is_typed && abstree->type != STRING;
+}
+
+/**
+ * This function determines whether a node is an operator whose operands are
+ * all literals and that can be evaluated without an error.  A fold that would
+ * stop the program (type mismatch, division by zero, ...) is left for the line
+ * to raise when it runs.
+ * @param abstree - the node to be checked
+ * @return     .\ - 1 if it can be folded, 0 otherwise
+ */
+int is_foldable_tree(ast * abstree) {
+  ast ** children = abstree->children;
+  binary_op op = binary_op_of(abstree->value.type);
+  unary_op fn = unary_op_of(abstree->value.type);
+  if(op == QTY_BINARY_OPS && fn == QTY_UNARY_OPS)
+    return 0;
+  for(int i = 0; i < abstree->no_children; i++)
+    if(children[i]->value.type != TOKEN_INT
+        && children[i]->value.type != TOKEN_DOUBLE
+        && children[i]->value.type != TOKEN_STRING)
+      return 0;
+  if(fn != QTY_UNARY_OPS)
+    return UNARY_KERNELS[fn][literal_type(children[0])] != NULL;
+  if(op == BINARY_DIV && children[0]->value.type == TOKEN_INT
+      && is_int_literal(children[1], 0))
+    return 0;
+  return BINARY_KERNELS[op][literal_type(children[0])]
+    [literal_type(children[1])] != NULL;
+}
+
+/**
+ * This function gives the type of the value of a literal node.
+ * @param abstree - the literal (TOKEN_INT, TOKEN_DOUBLE or TOKEN_STRING)
+ * @return     .\ - its type
+ */
+var_type literal_type(ast * abstree) {
+  switch(abstree->value.type) {
+    case TOKEN_INT:    return INT;
+    case TOKEN_DOUBLE: return DOUBLE;
+    default:           return STRING;
+  }
+}
+
+/**
+ * This function determines whether a node is a given INT literal.
+ * @param abstree - the node to be checked
+ * @param   value - the value of the literal
+ * @return     .\ - 1 if it is, 0 otherwise
+ */
+int is_int_literal(ast * abstree, long long value) {
+  return abstree->value.type == TOKEN_INT
+    && abstree->value.value.int_value == value;
+}
+
+/**
+ * This function evaluates a foldable node and turns it into a literal.
+ * @param       a - the arena the literal is allocated from
+ * @param abstree - the node to be folded
+ * @return abstree - the node, now a literal
+ */
+ast * fold_tree(arena * a, ast * abstree) {
+  ast_result result = evaluate_tree(abstree, NULL);
+  char * literal = NULL;
+  int len = 0;
+  switch(result.type) {
+    case INT:
+      len = snprintf(NULL, 0, "%lld", result.value.int_value);
+      literal = arena_alloc(a, len + 1);
+      snprintf(literal, len + 1, "%lld", result.value.int_value);
+      abstree->value = init_token(literal, len, TOKEN_INT);
+      abstree->value.value.int_value = result.value.int_value;
+      break;
+    case DOUBLE:
+      len = snprintf(NULL, 0, "%.17g", result.value.double_value);
+      literal = arena_alloc(a, len + 1);
+      snprintf(literal, len + 1, "%.17g", result.value.double_value);
+      abstree->value = init_token(literal, len, TOKEN_DOUBLE);
+      abstree->value.value.double_value = result.value.double_value;
+      break;
+    case STRING:
+      len = result.value.string_value->len;
+      literal = arena_strndup(a, shared_string_data(result.value.string_value),
+          len);
+      abstree->value = init_token(literal, len, TOKEN_STRING);
+      break;
+  }
+  // The literal has the type the operator had, and no kernel to run
+  abstree->type = result.type;
+  abstree->is_typed = 1;
+  abstree->kernel = NULL;
+  free_ast_result(result);
+  abstree->children = NULL;
+  abstree->no_children = 0;
+  return abstree;
+}
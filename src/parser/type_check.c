@@ -0,0 +1,182 @@
+/**
+ * @file   type_check.c
+ * @brief  This file contains the functions of the type checker.  A program is
+ * a straight line of statements, so the type of every variable at every
+ * statement is known from the assignments before it: each node of a resolved
+ * tree is annotated with the type of its value, a type error is reported
+ * before anything runs, and an operator whose operand types are known is
+ * given its kernel from BINARY_KERNELS.
+ * @author Matthew C. Lindeman
+ * @date   October 05, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/type_check.h"
+
+/**
+ * This function initializes a type environment in which no variable is set.
+ * @param N/a
+ * @return env - The new type environment.
+ */
+type_env * init_type_env(void) {
+  type_env * env = calloc(1, sizeof(struct TYPE_ENV_T));
+  env->types = calloc(INITIAL_TYPE_SLOTS, sizeof(var_type));
+  env->is_known = calloc(INITIAL_TYPE_SLOTS, sizeof(int));
+  env->cap = INITIAL_TYPE_SLOTS;
+  return env;
+}
+
+/**
+ * This function records the type a slot holds from now on.
+ * @param  env - The type environment.
+ * @param slot - The slot.
+ * @param type - The type.
+ * @return N/a
+ */
+void type_env_set(type_env * env, int slot, var_type type) {
+  int old_cap = env->cap;
+  if(slot >= env->cap) {
+    while(slot >= env->cap)
+      env->cap *= 2;
+    env->types = realloc(env->types, env->cap * sizeof(var_type));
+    env->is_known = realloc(env->is_known, env->cap * sizeof(int));
+    memset(env->is_known + old_cap, 0, (env->cap - old_cap) * sizeof(int));
+  }
+  env->types[slot] = type;
+  env->is_known[slot] = 1;
+}
+
+/**
+ * This function forgets the type of a slot (it was assigned a value whose
+ * type is not known).
+ * @param  env - The type environment.
+ * @param slot - The slot.
+ * @return N/a
+ */
+void type_env_forget(type_env * env, int slot) {
+  if(slot < env->cap)
+    env->is_known[slot] = 0;
+}
+
+/**
+ * This function annotates a resolved tree with the types of its nodes and
+ * records the type of the variable it assigns.  A variable that is not known
+ * to be set has no type, nor do the nodes that depend on it, so the checks of
+ * the ast_result functions still run for them.
+ * @param abstree - The tree (resolved with resolve_tree).
+ * @param     env - The types of the variables before the tree runs.
+ * @param     err - Set to the error found (if any).
+ * @return     .\ - 1 if the tree is well typed, 0 otherwise.
+ */
+int type_check_tree(ast * abstree, type_env * env, type_error * err) {
+  abstree->is_typed = 0;
+  abstree->kernel = NULL;
+  for(int i = abstree->value.type == TOKEN_ASSIGN; i < abstree->no_children;
+      i++)
+    if(!type_check_tree(abstree->children[i], env, err))
+      return 0;
+  switch(abstree->value.type) {
+    case TOKEN_INT:
+      abstree->type = INT;
+      abstree->is_typed = 1;
+      return 1;
+    case TOKEN_DOUBLE:
+      abstree->type = DOUBLE;
+      abstree->is_typed = 1;
+      return 1;
+    case TOKEN_STRING:
+      abstree->type = STRING;
+      abstree->is_typed = 1;
+      return 1;
+    case TOKEN_VAR:
+      if(abstree->slot != -1 && abstree->slot < env->cap
+          && env->is_known[abstree->slot]) {
+        abstree->type = env->types[abstree->slot];
+        abstree->is_typed = 1;
+      }
+      return 1;
+    case TOKEN_ASSIGN:
+      if(abstree->children[1]->is_typed)
+        type_env_set(env, abstree->slot, abstree->children[1]->type);
+      else
+        type_env_forget(env, abstree->slot);
+      abstree->type = INT;
+      abstree->is_typed = 1;
+      return 1;
+    default:
+      return type_check_operator(abstree, err);
+  }
+}
+
+/**
+ * This function checks an operator (or function) node whose children have
+ * been checked.
+ * @param abstree - The node.
+ * @param     err - Set to the error found (if any).
+ * @return     .\ - 1 if the node is well typed, 0 otherwise.
+ */
+int type_check_operator(ast * abstree, type_error * err) {
+  ast * lhs = abstree->children[0];
+  ast * rhs = abstree->no_children == 2 ? abstree->children[1] : NULL;
+  binary_op op = binary_op_of(abstree->value.type);
+  int is_comparison = op >= BINARY_EQ && op != QTY_BINARY_OPS;
+  err->op = abstree->value;
+  err->lhs = lhs->type;
+  err->rhs = rhs ? rhs->type : lhs->type;
+  err->is_unsupported = err->lhs == err->rhs;
+  // A comparison is always an INT (if it does not stop the program)
+  abstree->type = is_comparison ? INT : lhs->type;
+  abstree->is_typed = is_comparison;
+  if(!lhs->is_typed || (rhs && !rhs->is_typed))
+    return 1;
+  // `||` and lists have no row in the kernel tables
+  if(rhs ? op == QTY_BINARY_OPS
+      : unary_op_of(abstree->value.type) == QTY_UNARY_OPS) {
+    err->is_unsupported = 1;
+    return 0;
+  }
+  if(!rhs) {
+    if(!UNARY_KERNELS[unary_op_of(abstree->value.type)][lhs->type])
+      return 0;
+    abstree->is_typed = 1;
+    return 1;
+  }
+  abstree->kernel = BINARY_KERNELS[op][lhs->type][rhs->type];
+  if(!abstree->kernel)
+    return 0;
+  abstree->type = binary_result_type(op, lhs->type, rhs->type);
+  abstree->is_typed = 1;
+  return 1;
+}
+
+/**
+ * This function reports a type error found before the program ran and
+ * stops it.
+ * @param     err - The error.
+ * @param line_no - The line the error is on.
+ * @return    N/a
+ */
+void report_type_error(type_error * err, int line_no) {
+  if(err->is_unsupported)
+    fprintf(stderr, "[TYPE_CHECK]: Line %d: `%.*s` not Implemented for "
+        "%ss\nExiting\n", line_no, (int)err->op.len, err->op.t_literal,
+        var_type_to_string(err->lhs));
+  else
+    fprintf(stderr, "[TYPE_CHECK]: Line %d: Type Mismatch for `%.*s`:\n1) %s"
+        "\n2) %s\nExiting\n", line_no, (int)err->op.len, err->op.t_literal,
+        var_type_to_string(err->lhs), var_type_to_string(err->rhs));
+  exit(1);
+}
+
+/**
+ * This function frees a type environment.
+ * @param  env - The type environment to be freed.
+ * @return N/a
+ */
+void free_type_env(type_env * env) {
+  if(env) {
+    free(env->types);
+    free(env->is_known);
+    free(env);
+  }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file   program.h
+ * @brief  This file contains the function definitions for program.c
+ * @author Matthew C. Lindeman
+ * @date   September 28, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef PRG_H
+#define PRG_H
+
+#include <time.h>
+#include "../../console/include/options.h"
+#include "../../lexer/include/lexer.h"
+#include "../../parser/include/parser.h"
+#include "../../parser/include/type_check.h"
+#include "../../vm/include/vm.h"
+#include "../../closure/include/closure.h"
+#include "../../jit/include/jit.h"
+
+/** The number of statements a program starts with room for */
+#define INITIAL_STATEMENTS 16
+
+/**
+ * This structure is a single line of a program.
+ */
+typedef struct STATEMENT_T {
+  /** The (simplified) tree of the line */
+  ast * abstree;
+  /** The bytecode of the tree (with --engine=vm, NULL otherwise) */
+  chunk * ch;
+  /** The closures of the tree (with --engine=closure, NULL otherwise) */
+  closure * cl;
+  /** The native code of the tree (compiled on its first run, NULL if it can
+   * not be compiled) */
+  jit_function * jf;
+  /** Whether compiling the tree to native code was tried (with --no-jit it
+   * never is) */
+  int jit_tried;
+  /** The line of the source the statement is on */
+  int line_no;
+} statement;
+
+/**
+ * This structure counts what happened over a run of the interpreter.
+ */
+typedef struct RUN_STATS_T {
+  /** The number of statements parsed */
+  int qty_lines;
+  /** The number of nodes the parser produced */
+  int qty_nodes;
+  /** The number of nodes removed by simplify_tree */
+  int qty_eliminated;
+  /** The seconds spent lexing, parsing and compiling */
+  double front_end_time;
+  /** The seconds spent running statements */
+  double run_time;
+} run_stats;
+
+/**
+ * This structure is a whole script, parsed and compiled up front so it can be
+ * optimised as a whole and run any number of times.  Variables are resolved
+ * to slots of the layout, and a frame is bound to the layout before a run.
+ * Trees, chunks and the copies of names and strings they hold live in the
+ * program's arena, the trees still refer to the source they were parsed
+ * from.
+ */
+typedef struct PROGRAM_T {
+  /** The statements in source order */
+  statement * statements;
+  /** The number of statements */
+  int qty_statements;
+  /** The number of statements there is room for */
+  int cap_statements;
+  /** The arena the statements are allocated from */
+  arena * a;
+  /** The frame layout: every variable of the program declared in its slot */
+  symbol_table * layout;
+  /** The types of the variables of the layout after the last statement */
+  type_env * types;
+  /** The native code compiler (NULL with --no-jit) */
+  jit * j;
+} program;
+
+program * init_program(void);
+void parse_program(program * prog, const char * src, size_t len,
+    options * opts, run_stats * rs);
+statement * parse_statement(program * prog, token_buffer * tb, int line_no,
+    options * opts, run_stats * rs);
+void run_program(program * prog, vm * v, symbol_table ** st, run_stats * rs);
+ast_result run_statement(program * prog, statement * stmt, vm * v,
+    symbol_table ** st);
+void reset_program(program * prog);
+double seconds_now(void);
+void run_stats_dump(run_stats * rs, program * prog);
+void program_dump_debug(program * prog);
+void free_program(program * prog);
+
+#endif
@@ -0,0 +1,227 @@
+/**
+ * @file   program.c
+ * @brief  This file contains the functions relating to the program data
+ * structure, the parsed and compiled form of a whole script.
+ * @author Matthew C. Lindeman
+ * @date   September 28, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "include/program.h"
+
+/**
+ * This function initializes an empty program.
+ * @param N/a
+ * @return prog - The new program.
+ */
+program * init_program(void) {
+  program * prog = calloc(1, sizeof(struct PROGRAM_T));
+  prog->statements = calloc(INITIAL_STATEMENTS, sizeof(struct STATEMENT_T));
+  prog->qty_statements = 0;
+  prog->cap_statements = INITIAL_STATEMENTS;
+  prog->a = init_arena();
+  prog->layout = init_symbol_table();
+  prog->types = init_type_env();
+  return prog;
+}
+
+/**
+ * This function is the front end of the interpreter: it lexes, parses,
+ * simplifies and compiles every line of a source up to the line "exit" (or
+ * the end of the source) into a program.
+ * @param prog - The program the statements are added to.
+ * @param  src - The source (need not be NUL terminated).
+ * @param  len - The length of the source.
+ * @param opts - The command line options.
+ * @param   rs - The statistics of the run.
+ * @return N/a
+ */
+void parse_program(program * prog, const char * src, size_t len,
+    options * opts, run_stats * rs) {
+  double start = seconds_now();
+  lexer * lex = init_lexer(src, len);
+  token_buffer * tb = init_token_buffer();
+  int line_no = 0;
+  while(!lex_at_end(lex) && !lex_line_equals(lex, "exit")) {
+    line_no = lex->line_no;
+    lex_source(lex, tb);
+    if(CURRENT_TOKEN(tb).type == TOKEN_NEWLINE)
+      continue;
+    parse_statement(prog, tb, line_no, opts, rs);
+  }
+  free_token_buffer(tb);
+  free_lexer(lex);
+  rs->front_end_time += seconds_now() - start;
+}
+
+/**
+ * This function parses, type checks, simplifies and compiles (for the engine
+ * of opts) a lexed line, adding it to a program.  A type error stops the
+ * program before any of it runs.
+ * @param    prog - The program the statement is added to.
+ * @param      tb - The tokens of the line.
+ * @param line_no - The line of the source the tokens are from.
+ * @param    opts - The command line options.
+ * @param      rs - The statistics of the run.
+ * @return   stmt - The new statement.
+ */
+statement * parse_statement(program * prog, token_buffer * tb, int line_no,
+    options * opts, run_stats * rs) {
+  statement * stmt = NULL;
+  type_error err = {0};
+  ast * abstree = parse_expression(tb, prog->a);
+  int qty_nodes = ast_count_nodes(abstree);
+  rs->qty_lines++;
+  rs->qty_nodes += qty_nodes;
+  resolve_tree(abstree, prog->layout);
+  if(!type_check_tree(abstree, prog->types, &err))
+    report_type_error(&err, line_no);
+  // After the type checker, so that the identities know what x is
+  if(opts->simplify) {
+    abstree = simplify_tree(prog->a, abstree);
+    rs->qty_eliminated += qty_nodes - ast_count_nodes(abstree);
+  }
+  if(prog->qty_statements == prog->cap_statements) {
+    prog->cap_statements *= 2;
+    prog->statements = realloc(prog->statements, prog->cap_statements
+        * sizeof(struct STATEMENT_T));
+  }
+  stmt = &prog->statements[prog->qty_statements++];
+  stmt->abstree = abstree;
+  stmt->ch = opts->eng == ENGINE_VM ? compile_tree(abstree, prog->a) : NULL;
+  stmt->cl = opts->eng == ENGINE_CLOSURE ? compile_closure(abstree, prog->a)
+    : NULL;
+  stmt->jf = NULL;
+  stmt->jit_tried = !opts->jit;
+  if(opts->jit && !prog->j)
+    prog->j = init_jit();
+  stmt->line_no = line_no;
+  return stmt;
+}
+
+/**
+ * This function runs every statement of a program in order, printing the
+ * result of each.
+ * @param prog - The program to be run.
+ * @param    v - The vm the statements compiled to bytecode are run on.
+ * @param   st - The frame (empty, previously bound to the program, or the
+ *               layout of the program itself).
+ * @param   rs - The statistics of the run.
+ * @return N/a
+ */
+void run_program(program * prog, vm * v, symbol_table ** st, run_stats * rs) {
+  double start = seconds_now();
+  ast_result result = {0};
+  bind_symbol_table(st[0], prog->layout);
+  for(int i = 0; i < prog->qty_statements; i++) {
+    result = run_statement(prog, &prog->statements[i], v, st);
+    ast_print_result(result);
+    free_ast_result(result);
+  }
+  rs->run_time += seconds_now() - start;
+}
+
+/**
+ * This function runs a single statement with the engine it was compiled for.
+ * A numeric statement is compiled to native code the first time it is run,
+ * for the types its variables have then, and runs natively whenever they
+ * still have those types.
+ * @param prog - The program the statement is part of.
+ * @param stmt - The statement to be run.
+ * @param    v - The vm (for a statement compiled to bytecode).
+ * @param   st - The frame (bound to the layout of the program).
+ * @return  .\ - The value of the statement.
+ */
+ast_result run_statement(program * prog, statement * stmt, vm * v,
+    symbol_table ** st) {
+  ast_result result = {0};
+  if(!stmt->jit_tried) {
+    stmt->jit_tried = 1;
+    stmt->jf = jit_compile(prog->j, stmt->abstree, st[0], prog->a);
+  }
+  if(stmt->jf && jit_run(stmt->jf, st, &result))
+    return result;
+  if(stmt->cl)
+    return run_closure(stmt->cl, st);
+  if(stmt->ch)
+    return run_chunk(v, stmt->ch, st);
+  return evaluate_tree(stmt->abstree, st);
+}
+
+/**
+ * This function empties a program so that it can be reused, keeping the
+ * memory of its arena and statements, the slots of its layout and the types
+ * they hold.
+ * @param prog - The program to be reset.
+ * @return N/a
+ */
+void reset_program(program * prog) {
+  prog->qty_statements = 0;
+  reset_arena(prog->a);
+  if(prog->j)
+    reset_jit(prog->j);
+}
+
+/**
+ * This function reads the monotonic clock.
+ * @param N/a
+ * @return .\ - The time in seconds.
+ */
+double seconds_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * This function prints the statistics of a run to stderr.
+ * @param   rs - The statistics.
+ * @param prog - The program that was run.
+ * @return N/a
+ */
+void run_stats_dump(run_stats * rs, program * prog) {
+  fprintf(stderr, "Stats\n");
+  fprintf(stderr, "Lines: %d\n", rs->qty_lines);
+  fprintf(stderr, "Nodes Parsed: %d\n", rs->qty_nodes);
+  fprintf(stderr, "Nodes Eliminated: %d\n", rs->qty_eliminated);
+  fprintf(stderr, "Arena Mallocs: %zu\n", prog->a->total_mallocs);
+  fprintf(stderr, "JIT Functions: %d\n",
+      prog->j ? prog->j->qty_functions : 0);
+  fprintf(stderr, "Front End: %.6fs\n", rs->front_end_time);
+  fprintf(stderr, "Run: %.6fs\n", rs->run_time);
+  fprintf(stderr, "--\n");
+}
+
+/**
+ * This function is used for debugging programs.
+ * @param prog - The program to be debugged.
+ * @return N/a
+ */
+void program_dump_debug(program * prog) {
+  printf("Program\n");
+  for(int i = 0; i < prog->qty_statements; i++) {
+    printf("Line %d\n", prog->statements[i].line_no);
+    if(prog->statements[i].ch)
+      chunk_dump_debug(prog->statements[i].ch);
+    else
+      ast_dump_debug(prog->statements[i].abstree);
+  }
+  printf("--\n");
+}
+
+/**
+ * This function frees a program.
+ * @param prog - The program to be freed.
+ * @return N/a
+ */
+void free_program(program * prog) {
+  if(prog) {
+    free(prog->statements);
+    free_arena(prog->a);
+    free_symbol_table(prog->layout);
+    free_type_env(prog->types);
+    free_jit(prog->j);
+    free(prog);
+  }
+}
@@ -0,0 +1,66 @@
+/**
+ * @file   intern.h
+ * @brief  This file contains the function definitions for intern.c
+ * @author Matthew C. Lindeman
+ * @date   October 02, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef ITN_H
+#define ITN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** The number of buckets the intern table starts with (a power of 2). */
+#define INITIAL_ATOM_BUCKETS 64
+
+/**
+ * This structure is an interned identifier.  There is exactly one atom per
+ * distinct name, so two names are the same if and only if their atoms are
+ * the same pointer.  Atoms are never freed before the intern table.
+ */
+typedef struct ATOM_T {
+  /** The name (NUL terminated, stored right after the atom) */
+  const char * name;
+  /** The length of the name */
+  size_t len;
+  /** The hash of the name (computed once, when it is interned) */
+  unsigned int hash;
+  /** The id of the atom (the order in which it was interned) */
+  int id;
+} atom;
+
+/**
+ * This structure is the table every identifier is interned into.  Atoms are
+ * kept in the order they were interned and buckets is a linear probing hash
+ * index over them.
+ */
+typedef struct INTERN_TABLE_T {
+  /** The atoms, indexed by id */
+  atom ** atoms;
+  /** The hash index over atoms (-1 means the bucket is empty) */
+  int * buckets;
+  /** Quantity of atoms */
+  int qty_atoms;
+  /** Quantity of atoms there is room for */
+  int cap_atoms;
+  /** Quantity of buckets (always a power of 2) */
+  int qty_buckets;
+} intern_table;
+
+/** The intern table of the process (created by the first intern) */
+extern intern_table * INTERN_TABLE;
+
+intern_table * init_intern_table(void);
+unsigned int hash_name(const char * name, size_t len);
+const atom * intern(const char * name, size_t len);
+const atom * find_atom(const char * name, size_t len);
+int find_atom_bucket(intern_table * it, const char * name, size_t len,
+    unsigned int hash);
+void grow_intern_table(intern_table * it);
+void intern_table_dump_debug(void);
+void free_intern_table(void);
+
+#endif
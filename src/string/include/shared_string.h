@@ -0,0 +1,62 @@
+/**
+ * @file   shared_string.h
+ * @brief  This file contains the function definitions for shared_string.c
+ * @author Matthew C. Lindeman
+ * @date   October 01, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef SHS_H
+#define SHS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../arena/include/arena.h"
+
+/** The shortest concatenation of a shared string that is made a rope */
+#define ROPE_MIN_LEN 64
+/** The number of entries the work stack of a rope walk starts with */
+#define ROPE_STACK_SIZE 32
+
+/**
+ * This structure is an immutable, length prefixed string shared by reference
+ * between values, variables and literals.  Copying a string is taking a
+ * reference to it and a string is only written to when it has a single owner
+ * (copy on write).  A string with no reference count (refs of 0) belongs to
+ * an arena, it is never freed and is copied by anything that outlives the
+ * arena.
+ *
+ * Concatenating onto a string with a single owner appends to it in place
+ * (its capacity grows geometrically, like a string builder).  Concatenating
+ * onto a shared string makes a rope node that refers to both halves, its
+ * bytes are only produced when they are first read.
+ */
+typedef struct SHARED_STRING_T {
+  /** The number of owners of the string (0 for an arena string) */
+  size_t refs;
+  /** The length of the string */
+  size_t len;
+  /** The number of bytes allocated for data */
+  size_t cap;
+  /** The bytes of the string (NUL terminated, NULL for an unread rope) */
+  char * data;
+  /** The first half of a rope node */
+  struct SHARED_STRING_T * left;
+  /** The second half of a rope node */
+  struct SHARED_STRING_T * right;
+} shared_string;
+
+shared_string * init_shared_string(const char * s, size_t len);
+shared_string * arena_shared_string(arena * a, const char * s, size_t len);
+shared_string * retain_shared_string(shared_string * ss);
+shared_string * keep_shared_string(shared_string * ss);
+shared_string * unique_shared_string(shared_string * ss, size_t len);
+shared_string * shared_string_concat(shared_string * ss1, shared_string * ss2);
+const char * shared_string_data(shared_string * ss);
+void flatten_shared_string(shared_string * ss);
+int shared_string_equals(shared_string * ss1, shared_string * ss2);
+void release_shared_string(shared_string * ss);
+void free_shared_string(shared_string * ss);
+
+#endif
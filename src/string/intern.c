@@ -0,0 +1,172 @@
+/**
+ * @file   intern.c
+ * @brief  This file contains the functions relating to the intern table of
+ * identifiers (atoms).
+ * @author Matthew C. Lindeman
+ * @date   October 02, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/intern.h"
+
+intern_table * INTERN_TABLE = NULL;
+
+/**
+ * This function initializes an empty intern table.
+ * @param N/a
+ * @return it - The new intern table.
+ */
+intern_table * init_intern_table(void) {
+  intern_table * it = calloc(1, sizeof(struct INTERN_TABLE_T));
+  it->atoms = NULL;
+  it->qty_atoms = 0;
+  it->cap_atoms = 0;
+  it->qty_buckets = INITIAL_ATOM_BUCKETS;
+  it->buckets = malloc(it->qty_buckets * sizeof(int));
+  for(int i = 0; i < it->qty_buckets; i++)
+    it->buckets[i] = -1;
+  return it;
+}
+
+/**
+ * This function hashes a name (32 bit FNV-1a).
+ * @param name - The name to be hashed.
+ * @param  len - The length of the name.
+ * @return hash - The hash of name.
+ */
+unsigned int hash_name(const char * name, size_t len) {
+  unsigned int hash = 2166136261u;
+  for(size_t i = 0; i < len; i++) {
+    hash ^= (unsigned char)name[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * This function finds the bucket of a name in an intern table, that is the
+ * bucket holding its atom or the empty bucket it would go in.
+ * @param   it - The intern table.
+ * @param name - The name (need not be NUL terminated).
+ * @param  len - The length of the name.
+ * @param hash - The hash of the name.
+ * @return  .\ - The index of the bucket.
+ */
+int find_atom_bucket(intern_table * it, const char * name, size_t len,
+    unsigned int hash) {
+  unsigned int mask = it->qty_buckets - 1;
+  unsigned int i = hash & mask;
+  atom * at = NULL;
+  for(; it->buckets[i] != -1; i = (i + 1) & mask) {
+    at = it->atoms[it->buckets[i]];
+    if(at->hash == hash && at->len == len && !memcmp(at->name, name, len))
+      break;
+  }
+  return i;
+}
+
+/**
+ * This function gives the atom of a name, interning the name if it has not
+ * been seen before.
+ * @param name - The name (need not be NUL terminated).
+ * @param  len - The length of the name.
+ * @return  .\ - The atom of the name.
+ */
+const atom * intern(const char * name, size_t len) {
+  unsigned int hash = hash_name(name, len);
+  intern_table * it = INTERN_TABLE;
+  atom * at = NULL;
+  int bucket = 0;
+  if(!it)
+    it = INTERN_TABLE = init_intern_table();
+  bucket = find_atom_bucket(it, name, len, hash);
+  if(it->buckets[bucket] != -1)
+    return it->atoms[it->buckets[bucket]];
+  // The atom and its name are a single allocation
+  at = malloc(sizeof(struct ATOM_T) + len + 1);
+  memcpy(at + 1, name, len);
+  ((char *)(at + 1))[len] = '\0';
+  at->name = (const char *)(at + 1);
+  at->len = len;
+  at->hash = hash;
+  at->id = it->qty_atoms;
+  if(it->qty_atoms == it->cap_atoms) {
+    it->cap_atoms = it->cap_atoms ? 2 * it->cap_atoms
+      : INITIAL_ATOM_BUCKETS / 2;
+    it->atoms = realloc(it->atoms, it->cap_atoms * sizeof(struct ATOM_T *));
+  }
+  it->atoms[it->qty_atoms++] = at;
+  it->buckets[bucket] = at->id;
+  // Keep the load factor of the index at or below one half
+  if(2 * it->qty_atoms > it->qty_buckets)
+    grow_intern_table(it);
+  return at;
+}
+
+/**
+ * This function gives the atom of a name without interning it.
+ * @param name - The name (need not be NUL terminated).
+ * @param  len - The length of the name.
+ * @return  .\ - The atom of the name, NULL if it was never interned.
+ */
+const atom * find_atom(const char * name, size_t len) {
+  int bucket = 0;
+  if(!INTERN_TABLE)
+    return NULL;
+  bucket = find_atom_bucket(INTERN_TABLE, name, len, hash_name(name, len));
+  return INTERN_TABLE->buckets[bucket] == -1 ? NULL
+    : INTERN_TABLE->atoms[INTERN_TABLE->buckets[bucket]];
+}
+
+/**
+ * This function doubles the number of buckets of an intern table and
+ * rehashes it (the hashes stored in the atoms are reused).
+ * @param   it - The intern table to be grown.
+ * @return N/a
+ */
+void grow_intern_table(intern_table * it) {
+  unsigned int mask = 0;
+  unsigned int j = 0;
+  free(it->buckets);
+  it->qty_buckets *= 2;
+  mask = it->qty_buckets - 1;
+  it->buckets = malloc(it->qty_buckets * sizeof(int));
+  for(int i = 0; i < it->qty_buckets; i++)
+    it->buckets[i] = -1;
+  for(int i = 0; i < it->qty_atoms; i++) {
+    for(j = it->atoms[i]->hash & mask; it->buckets[j] != -1; j = (j + 1) & mask)
+      ;
+    it->buckets[j] = i;
+  }
+}
+
+/**
+ * This function is used in debugging the intern table.
+ * @param N/a
+ * @return N/a
+ */
+void intern_table_dump_debug(void) {
+  printf("Intern Table\n");
+  if(INTERN_TABLE)
+    for(int i = 0; i < INTERN_TABLE->qty_atoms; i++)
+      printf("%4d `%s` %08x\n", i, INTERN_TABLE->atoms[i]->name,
+          INTERN_TABLE->atoms[i]->hash);
+  printf("--\n");
+}
+
+/**
+ * This function frees the intern table and every atom in it.  Nothing may
+ * hold an atom afterwards.
+ * @param N/a
+ * @return N/a
+ */
+void free_intern_table(void) {
+  if(INTERN_TABLE) {
+    for(int i = 0; i < INTERN_TABLE->qty_atoms; i++)
+      free(INTERN_TABLE->atoms[i]);
+    free(INTERN_TABLE->atoms);
+    free(INTERN_TABLE->buckets);
+    free(INTERN_TABLE);
+    INTERN_TABLE = NULL;
+  }
+}
@@ -0,0 +1,258 @@
+/**
+ * @file   shared_string.c
+ * @brief  This file contains the functions relating to the shared_string data
+ * structure.
+ * @author Matthew C. Lindeman
+ * @date   October 01, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/shared_string.h"
+
+/**
+ * This function initializes a heap string with one owner.  The header and
+ * the bytes are a single allocation.
+ * @param   s - The bytes of the string (need not be NUL terminated).
+ * @param len - The length of the string.
+ * @return ss - The new string.
+ */
+shared_string * init_shared_string(const char * s, size_t len) {
+  shared_string * ss = malloc(sizeof(struct SHARED_STRING_T) + len + 1);
+  ss->refs = 1;
+  ss->len = len;
+  ss->cap = len + 1;
+  ss->data = (char *)(ss + 1);
+  ss->left = NULL;
+  ss->right = NULL;
+  memcpy(ss->data, s, len);
+  ss->data[len] = '\0';
+  return ss;
+}
+
+/**
+ * This function initializes a string that lives in an arena (i.e. a literal
+ * of a compiled statement).
+ * @param   a - The arena the string is allocated from.
+ * @param   s - The bytes of the string (need not be NUL terminated).
+ * @param len - The length of the string.
+ * @return ss - The new string.
+ */
+shared_string * arena_shared_string(arena * a, const char * s, size_t len) {
+  shared_string * ss = arena_alloc(a, sizeof(struct SHARED_STRING_T));
+  ss->refs = 0;
+  ss->len = len;
+  ss->cap = len + 1;
+  ss->data = arena_strndup(a, s, len);
+  ss->left = NULL;
+  ss->right = NULL;
+  return ss;
+}
+
+/**
+ * This function takes a reference to a string.
+ * @param ss - The string.
+ * @return ss - The same string.
+ */
+shared_string * retain_shared_string(shared_string * ss) {
+  if(ss->refs)
+    ss->refs++;
+  return ss;
+}
+
+/**
+ * This function takes a reference to a string that may be kept past the life
+ * of the arena it came from (an arena string is copied to the heap).
+ * @param ss - The string.
+ * @return .\ - A string owned by the caller.
+ */
+shared_string * keep_shared_string(shared_string * ss) {
+  if(!ss->refs)
+    return init_shared_string(ss->data, ss->len);
+  return retain_shared_string(ss);
+}
+
+/**
+ * This function makes a string writable with room for at least len bytes,
+ * copying it if it has other owners (copy on write).  The capacity of a
+ * string with a single owner grows geometrically.  The reference passed in
+ * is consumed.
+ * @param  ss - The string.
+ * @param len - The number of bytes the caller needs.
+ * @return ss - A flat string with a single owner (the caller).
+ */
+shared_string * unique_shared_string(shared_string * ss, size_t len) {
+  shared_string * copy = NULL;
+  size_t cap = 0;
+  if(ss->refs == 1) {
+    flatten_shared_string(ss);
+    if(ss->cap < len + 1) {
+      cap = 2 * ss->cap > len + 1 ? 2 * ss->cap : len + 1;
+      if(ss->data == (char *)(ss + 1)) {
+        ss->data = malloc(cap);
+        memcpy(ss->data, ss + 1, ss->len + 1);
+      } else {
+        ss->data = realloc(ss->data, cap);
+      }
+      ss->cap = cap;
+    }
+    return ss;
+  }
+  copy = malloc(sizeof(struct SHARED_STRING_T) + len + 1);
+  copy->refs = 1;
+  copy->len = ss->len;
+  copy->cap = len + 1;
+  copy->data = (char *)(copy + 1);
+  copy->left = NULL;
+  copy->right = NULL;
+  memcpy(copy->data, shared_string_data(ss), ss->len + 1);
+  release_shared_string(ss);
+  return copy;
+}
+
+/**
+ * This function concatenates two strings.  Both references are consumed.  The
+ * first string is appended to in place when nothing else refers to it, a long
+ * concatenation onto a shared string is a rope node (so building a string up
+ * in a variable is linear rather than quadratic).
+ * @param ss1 - The first string.
+ * @param ss2 - The second string.
+ * @return .\ - The concatenation.
+ */
+shared_string * shared_string_concat(shared_string * ss1, shared_string * ss2) {
+  size_t len = ss1->len + ss2->len;
+  shared_string * node = NULL;
+  if(ss1->refs != 1 && len >= ROPE_MIN_LEN) {
+    node = malloc(sizeof(struct SHARED_STRING_T));
+    node->refs = 1;
+    node->len = len;
+    node->cap = 0;
+    node->data = NULL;
+    node->left = keep_shared_string(ss1);
+    node->right = keep_shared_string(ss2);
+    release_shared_string(ss1);
+    release_shared_string(ss2);
+    return node;
+  }
+  ss1 = unique_shared_string(ss1, len);
+  memcpy(ss1->data + ss1->len, shared_string_data(ss2), ss2->len);
+  ss1->len = len;
+  ss1->data[len] = '\0';
+  release_shared_string(ss2);
+  return ss1;
+}
+
+/**
+ * This function gives the bytes of a string, flattening it if it is a rope.
+ * @param ss - The string.
+ * @return .\ - The bytes (NUL terminated).
+ */
+const char * shared_string_data(shared_string * ss) {
+  if(!ss->data)
+    flatten_shared_string(ss);
+  return ss->data;
+}
+
+/**
+ * This function turns a rope node into a flat string in place, dropping its
+ * halves.  The rope is walked with an explicit stack as a string built up one
+ * piece at a time is a rope as deep as the number of pieces.
+ * @param ss - The string.
+ * @return N/a
+ */
+void flatten_shared_string(shared_string * ss) {
+  shared_string ** stack = NULL;
+  shared_string * node = NULL;
+  size_t qty_stack = 0;
+  size_t cap_stack = ROPE_STACK_SIZE;
+  size_t pos = 0;
+  if(ss->data)
+    return;
+  ss->data = malloc(ss->len + 1);
+  ss->cap = ss->len + 1;
+  stack = malloc(cap_stack * sizeof(shared_string *));
+  stack[qty_stack++] = ss->right;
+  stack[qty_stack++] = ss->left;
+  while(qty_stack) {
+    node = stack[--qty_stack];
+    if(node->data) {
+      memcpy(ss->data + pos, node->data, node->len);
+      pos += node->len;
+      continue;
+    }
+    if(qty_stack + 2 > cap_stack) {
+      cap_stack *= 2;
+      stack = realloc(stack, cap_stack * sizeof(shared_string *));
+    }
+    stack[qty_stack++] = node->right;
+    stack[qty_stack++] = node->left;
+  }
+  ss->data[ss->len] = '\0';
+  free(stack);
+  release_shared_string(ss->left);
+  release_shared_string(ss->right);
+  ss->left = NULL;
+  ss->right = NULL;
+}
+
+/**
+ * This function compares two strings (the references are not consumed).
+ * @param ss1 - The first string.
+ * @param ss2 - The second string.
+ * @return .\ - 1 if they are equal, 0 otherwise.
+ */
+int shared_string_equals(shared_string * ss1, shared_string * ss2) {
+  return ss1 == ss2 || (ss1->len == ss2->len
+      && !memcmp(shared_string_data(ss1), shared_string_data(ss2), ss1->len));
+}
+
+/**
+ * This function drops a reference to a string, freeing it with its last
+ * owner.
+ * @param ss - The string.
+ * @return N/a
+ */
+void release_shared_string(shared_string * ss) {
+  if(ss && ss->refs && --ss->refs == 0)
+    free_shared_string(ss);
+}
+
+/**
+ * This function frees a string that has no owners left, along with the halves
+ * of a rope that were only owned by it (iteratively, see
+ * flatten_shared_string).
+ * @param ss - The string.
+ * @return N/a
+ */
+void free_shared_string(shared_string * ss) {
+  shared_string ** stack = NULL;
+  shared_string * node = NULL;
+  shared_string * halves[2] = {NULL, NULL};
+  size_t qty_stack = 0;
+  size_t cap_stack = ROPE_STACK_SIZE;
+  if(!ss->left) {
+    if(ss->data != (char *)(ss + 1))
+      free(ss->data);
+    free(ss);
+    return;
+  }
+  stack = malloc(cap_stack * sizeof(shared_string *));
+  stack[qty_stack++] = ss;
+  while(qty_stack) {
+    node = stack[--qty_stack];
+    halves[0] = node->left;
+    halves[1] = node->right;
+    for(int i = 0; i < 2; i++) {
+      if(!halves[i] || --halves[i]->refs)
+        continue;
+      if(qty_stack == cap_stack) {
+        cap_stack *= 2;
+        stack = realloc(stack, cap_stack * sizeof(shared_string *));
+      }
+      stack[qty_stack++] = halves[i];
+    }
+    if(node->data && node->data != (char *)(node + 1))
+      free(node->data);
+    free(node);
+  }
+  free(stack);
+}
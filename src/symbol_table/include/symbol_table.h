@@ -11,24 +11,55 @@
 
 #include <string.h>
 #include "variable.h"
-#include "../../main/include/constants.h"
+
+/** The number of buckets a new symbol_table starts with (a power of 2). */
+#define INITIAL_BUCKETS 16
+
+/**
+ * This struct is a single bucket of the open addressing index of a
+ * symbol_table.
+ */
+typedef struct SYMBOL_BUCKET_T {
+  /** The hash of the atom of the variable in this bucket. */
+  unsigned int hash;
+  /** The index of the variable in udv (-1 means the bucket is empty). */
+  int index;
+} symbol_bucket;
 
 /**
  * This struct is used to manage the memory of each process stack frame.
+ * Variables live in udv in the order they were added, buckets is a linear
+ * probing hash index over udv so lookups do not scan every variable.
  */
 typedef struct SYMBOL_TABLE_T {
   /** List of user defined variables. */
   variable ** udv;
+  /** The hash index over udv. */
+  symbol_bucket * buckets;
   /** The previous process stack frame. */
   struct SYMBOL_TABLE_T * previous;
   /** Quantity of user defined variables. */
   int qty_udv;
+  /** Quantity of variables udv has room for. */
+  int cap_udv;
+  /** Quantity of buckets (always a power of 2). */
+  int qty_buckets;
 } symbol_table;
 
 symbol_table * init_symbol_table(void);
 int find_variable(symbol_table * st, const char * name);
+int find_variable_n(symbol_table * st, const char * name, size_t len);
+int find_variable_atom(symbol_table * st, const atom * name);
 void add_variable(symbol_table * st, variable * var);
-void add_variable_at_index(symbol_table * st, variable * var, int index);
+void insert_bucket(symbol_table * st, unsigned int hash, int index);
+void grow_buckets(symbol_table * st);
+int assign_variable(symbol_table * st, const char * name, size_t len,
+    void * literal, var_type vt);
+void assign_variable_at(symbol_table * st, int index, void * literal,
+    var_type vt);
+int declare_variable(symbol_table * st, const char * name, size_t len);
+int declare_variable_atom(symbol_table * st, const atom * name);
+void bind_symbol_table(symbol_table * st, symbol_table * layout);
 void free_symbol_table(symbol_table * st);
 
 #endif
@@ -18,12 +18,15 @@
 typedef enum {
   /** Type double, defined by c99 std. */
   DOUBLE,
-  /** Type int, defined by c99 std. */
+  /** Type int, a c99 long long. */
   INT,
   /** Type string, literal bytes on the program heap. */
   STRING
 } var_type;
 
+/** The number of var_types (the size of a table indexed by them) */
+#define QTY_VAR_TYPES 3
+
 const char * var_type_to_string(var_type vt);
 
 #endif
@@ -13,21 +13,37 @@
 #include <stdlib.h>
 #include <string.h>
 #include "var_type.h"
-#include "../../main/include/constants.h"
+#include "../../string/include/shared_string.h"
+#include "../../string/include/intern.h"
 
 /**
- * This structure is used to represent a variable in the symbol_table
+ * This structure is used to represent a variable in the symbol_table.  Scalars
+ * are held inline and a variable is updated in place, a string is held by
+ * reference so assigning one is a pointer copy.
  */
 typedef struct VARIABLE_T {
-  /** The name of the variable */
-  char * name;
-  /** The value of the variable */
-  void * literal;
+  /** The name of the variable (interned, not owned by the variable) */
+  const atom * name;
+  /** The value of an INT/DOUBLE variable */
+  union {
+    /** The value of an INT variable */
+    long long int_value;
+    /** The value of a DOUBLE variable */
+    double double_value;
+  } value;
+  /** The value of a STRING variable (a reference owned by the variable) */
+  shared_string * string_value;
   /** The type of the variable */
   var_type type;
+  /** Whether the variable has a value (0 while it is only declared) */
+  int is_set;
 } variable;
 
 variable * init_variable(char * name, void * literal, var_type vt);
+variable * init_variable_n(const char * name, size_t len, void * literal,
+    var_type vt);
+variable * init_variable_atom(const atom * name, void * literal, var_type vt);
+void set_variable(variable * var, void * literal, var_type vt);
 void variable_dump_debug(variable * var);
 void free_variable(variable * var);
 
@@ -20,6 +20,11 @@ symbol_table * init_symbol_table(void) {
   symbol_table * st = calloc(1, sizeof(struct SYMBOL_TABLE_T));
   st->udv = NULL;
   st->qty_udv = 0;
+  st->cap_udv = 0;
+  st->qty_buckets = INITIAL_BUCKETS;
+  st->buckets = calloc(st->qty_buckets, sizeof(struct SYMBOL_BUCKET_T));
+  for(int i = 0; i < st->qty_buckets; i++)
+    st->buckets[i].index = -1;
   st->previous = NULL;
   return st;
 }
@@ -32,9 +37,38 @@ symbol_table * init_symbol_table(void) {
  *           i - The variable was found at index i.
  */
 int find_variable(symbol_table * st, const char * name) {
-  for(int i = 0; i < st->qty_udv; i++)
-    if(!strncmp(st->udv[i]->name, name, MAX_TOK_LEN))
-      return i;
+  return find_variable_n(st, name, strlen(name));
+}
+
+/**
+ * This function finds a variable given a name that is not NUL terminated
+ * (i.e. the literal of a token).
+ * @param   st - The symbol_table to be queried.
+ * @param name - The name of the variable to be found.
+ * @param  len - The length of the name.
+ * @return  -1 - The variable was not found.
+ *           i - The variable was found at index i.
+ */
+int find_variable_n(symbol_table * st, const char * name, size_t len) {
+  const atom * at = find_atom(name, len);
+  // A name that was never interned can not be the name of a variable
+  return at ? find_variable_atom(st, at) : -1;
+}
+
+/**
+ * This function finds a variable given the atom of its name, names are
+ * compared by pointer.
+ * @param   st - The symbol_table to be queried.
+ * @param name - The atom of the name of the variable to be found.
+ * @return  -1 - The variable was not found.
+ *           i - The variable was found at index i.
+ */
+int find_variable_atom(symbol_table * st, const atom * name) {
+  unsigned int mask = st->qty_buckets - 1;
+  for(unsigned int i = name->hash & mask; st->buckets[i].index != -1;
+      i = (i + 1) & mask)
+    if(st->udv[st->buckets[i].index]->name == name)
+      return st->buckets[i].index;
   return -1;
 }
 
@@ -45,17 +79,125 @@ int find_variable(symbol_table * st, const char * name) {
  * @return N/a
  */
 void add_variable(symbol_table * st, variable * var) {
+  if(st->qty_udv == st->cap_udv) {
+    st->cap_udv = st->cap_udv ? 2 * st->cap_udv : INITIAL_BUCKETS / 2;
+    st->udv = realloc(st->udv, st->cap_udv * sizeof(struct VARIABLE_T *));
+  }
   st->qty_udv++;
-  if(st->qty_udv == 1)
-    st->udv = calloc(1, sizeof(struct VARIABLE_T *));
-  else
-    st->udv = realloc(st->udv, st->qty_udv * sizeof(struct VARIABLE_T *));
   st->udv[st->qty_udv - 1] = var;
+  // Keep the load factor of the index at or below one half
+  if(2 * st->qty_udv > st->qty_buckets)
+    grow_buckets(st);
+  insert_bucket(st, var->name->hash, st->qty_udv - 1);
 }
 
-void add_variable_at_index(symbol_table * st, variable * var, int index) {
-  if(st->udv[index])
-    st->udv[index] = var;
+/**
+ * This function places an index into the first free bucket for hash.
+ * @param    st - The symbol_table whose index is inserted into.
+ * @param  hash - The hash of the name of the variable.
+ * @param index - The index of the variable in udv.
+ * @return  N/a
+ */
+void insert_bucket(symbol_table * st, unsigned int hash, int index) {
+  unsigned int mask = st->qty_buckets - 1;
+  unsigned int i = hash & mask;
+  while(st->buckets[i].index != -1)
+    i = (i + 1) & mask;
+  st->buckets[i].hash = hash;
+  st->buckets[i].index = index;
+}
+
+/**
+ * This function doubles the number of buckets of a symbol_table and rehashes
+ * it (the stored hashes are reused, names are not hashed again).
+ * @param   st - The symbol_table to be grown.
+ * @return N/a
+ */
+void grow_buckets(symbol_table * st) {
+  symbol_bucket * old = st->buckets;
+  int qty_old = st->qty_buckets;
+  st->qty_buckets *= 2;
+  st->buckets = calloc(st->qty_buckets, sizeof(struct SYMBOL_BUCKET_T));
+  for(int i = 0; i < st->qty_buckets; i++)
+    st->buckets[i].index = -1;
+  for(int i = 0; i < qty_old; i++)
+    if(old[i].index != -1)
+      insert_bucket(st, old[i].hash, old[i].index);
+  free(old);
+}
+
+/**
+ * This function assigns a value to the variable of name name, either by
+ * replacing the variable if it already exists or by adding it.
+ * @param      st - The symbol_table for the given process stack.
+ * @param    name - The name of the variable.
+ * @param     len - The length of the name of the variable.
+ * @param literal - A pointer to the value (long long *, double * or
+ *                  shared_string *).
+ * @param      vt - The variable type of the value.
+ * @return     .\ - The index of the variable in the symbol_table.
+ */
+int assign_variable(symbol_table * st, const char * name, size_t len,
+    void * literal, var_type vt) {
+  int variable_index = declare_variable(st, name, len);
+  assign_variable_at(st, variable_index, literal, vt);
+  return variable_index;
+}
+
+/**
+ * This function assigns a value to the variable in a given slot (in place).
+ * @param      st - The symbol_table for the given process stack.
+ * @param   index - The slot of the variable (from declare_variable).
+ * @param literal - A pointer to the value (long long *, double * or
+ *                  shared_string *).
+ * @param      vt - The variable type of the value.
+ * @return    N/a
+ */
+void assign_variable_at(symbol_table * st, int index, void * literal,
+    var_type vt) {
+  set_variable(st->udv[index], literal, vt);
+}
+
+/**
+ * This function gives a name a slot in a symbol_table.  If the name has no
+ * slot yet it is added as an unset variable.
+ * @param   st - The symbol_table for the given process stack.
+ * @param name - The name of the variable (need not be NUL terminated).
+ * @param  len - The length of the name.
+ * @return  .\ - The slot (index in udv) of the variable.
+ */
+int declare_variable(symbol_table * st, const char * name, size_t len) {
+  return declare_variable_atom(st, intern(name, len));
+}
+
+/**
+ * This function gives an interned name a slot in a symbol_table.  If the name
+ * has no slot yet it is added as an unset variable.
+ * @param   st - The symbol_table for the given process stack.
+ * @param name - The atom of the name of the variable.
+ * @return  .\ - The slot (index in udv) of the variable.
+ */
+int declare_variable_atom(symbol_table * st, const atom * name) {
+  int variable_index = find_variable_atom(st, name);
+  if(variable_index != -1)
+    return variable_index;
+  add_variable(st, init_variable_atom(name, NULL, INT));
+  return st->qty_udv - 1;
+}
+
+/**
+ * This function declares every variable of a layout in a symbol_table, in
+ * order, so that slots resolved against the layout index the symbol_table.
+ * The symbol_table must be empty or have been bound to the same layout.
+ * @param     st - The symbol_table to be bound.
+ * @param layout - The symbol_table whose slots are to be reproduced.
+ * @return   N/a
+ */
+void bind_symbol_table(symbol_table * st, symbol_table * layout) {
+  if(st == layout)
+    return;
+  for(int i = st->qty_udv; i < layout->qty_udv; i++)
+    add_variable(st, init_variable_atom(layout->udv[i]->name, NULL, INT));
 }
 
 /**
@@ -71,6 +213,8 @@ void free_symbol_table(symbol_table * st) {
           free_variable(st->udv[i]);
       free(st->udv);
     }
+    if(st->buckets)
+      free(st->buckets);
     if(st->previous)
       free_symbol_table(st->previous);
     free(st);
@@ -13,36 +13,75 @@
 /**
  * This funciton initializes a variable with name and literal value.
  * @param    name - The name of the new variable.
- * @param literal - The literal value of the variable (akin to *id*).
+ * @param literal - The literal value of the variable (akin to *id*), NULL to
+ *                  only declare it.
  * @param      vt - The variable type.
  * @return
  */
 variable * init_variable(char * name, void * literal, var_type vt) {
+  return init_variable_n(name, strlen(name), literal, vt);
+}
+
+/**
+ * This funciton initializes a variable with a name that is not NUL terminated
+ * (i.e. the literal of a token).  A NULL literal declares the variable without
+ * giving it a value.
+ * @param    name - The name of the new variable.
+ * @param name_len - The length of the name.
+ * @param literal - The literal value of the variable (akin to *id*).
+ * @param      vt - The variable type.
+ * @return
+ */
+variable * init_variable_n(const char * name, size_t name_len, void * literal,
+    var_type vt) {
+  return init_variable_atom(intern(name, name_len), literal, vt);
+}
+
+/**
+ * This funciton initializes a variable with an interned name.  A NULL literal
+ * declares the variable without giving it a value.
+ * @param    name - The atom of the name of the new variable.
+ * @param literal - The literal value of the variable (akin to *id*).
+ * @param      vt - The variable type.
+ * @return
+ */
+variable * init_variable_atom(const atom * name, void * literal, var_type vt) {
   variable * var = calloc(1, sizeof(struct VARIABLE_T));
-  size_t len = 0;
+  var->name = name;
+  var->string_value = NULL;
+  var->type = vt;
+  var->is_set = 0;
+  if(literal)
+    set_variable(var, literal, vt);
+  return var;
+}
+
+/**
+ * This function gives a variable a new value in place.  A string is shared
+ * with the caller rather than copied (unless it lives in an arena).
+ * @param     var - The variable to be assigned.
+ * @param literal - A pointer to the value (long long *, double * or
+ *                  shared_string *).
+ * @param      vt - The variable type of the value.
+ * @return    N/a
+ */
+void set_variable(variable * var, void * literal, var_type vt) {
+  shared_string * old = var->string_value;
+  var->string_value = NULL;
   var->type = vt;
-  len = strnlen(name, MAX_TOK_LEN) + 1;
-  var->name = calloc(len, sizeof(char));
-  strncpy(var->name, name, len);
+  var->is_set = 1;
   switch(vt) {
     case DOUBLE:
-      var->literal = calloc(1, sizeof(double));
-      // C is awesome!! :)
-      *((double *)var->literal) = *(double*)literal;
+      var->value.double_value = *(double *)literal;
       break;
     case INT:
-      var->literal = calloc(1, sizeof(int));
-      // C is awesome!! :)
-      *((int *)var->literal) = *(int*)literal;
+      var->value.int_value = *(long long *)literal;
       break;
     case STRING:
-      // C is awesome!! :)
-      len = strnlen((char *)literal, MAX_TOK_LEN) + 1;
-      var->literal = calloc(len, sizeof(char));
-      strncpy((char *)var->literal, literal, len);
+      var->string_value = keep_shared_string((shared_string *)literal);
       break;
   }
-  return var;
+  release_shared_string(old);
 }
 
 /**
@@ -52,17 +91,21 @@ variable * init_variable(char * name, void * literal, var_type vt) {
  */
 void variable_dump_debug(variable * var) {
   printf("Variable\n");
-  printf("Name: `%s`\n", var->name);
+  printf("Name: `%s`\n", var->name->name);
   printf("Value: ");
+  if(!var->is_set) {
+    printf("(unset)\n--\n");
+    return;
+  }
   switch(var->type) {
     case INT:
-      printf("%d\n", *((int *)var->literal));
+      printf("%lld\n", var->value.int_value);
       break;
     case DOUBLE:
-      printf("%f\n", *((double *)var->literal));
+      printf("%f\n", var->value.double_value);
       break;
     case STRING:
-      printf("`%s`\n", (char *)var->literal);
+      printf("`%s`\n", shared_string_data(var->string_value));
       break;
   }
   printf("--\n");
@@ -75,10 +118,7 @@ void variable_dump_debug(variable * var) {
  */
 void free_variable(variable * var) {
   if(var) {
-    if(var->name)
-      free(var->name);
-    if(var->literal)
-      free(var->literal);
+    release_shared_string(var->string_value);
     free(var);
   }
 }
@@ -11,20 +11,34 @@
 
 #include <string.h>
 #include "token_type.h"
-#include "../../main/include/constants.h"
+#include "../../string/include/intern.h"
 
 /**
- * This structure is used to represent a token.
+ * This structure is used to represent a token.  A token does not own its
+ * literal, it is a slice of the source it was lexed from (or of a string
+ * constant) and it is not NUL terminated.
  */
 typedef struct TOKEN_T {
   /** The literal string of the token */
-  char * t_literal;
+  const char * t_literal;
+  /** The length of the literal string of the token */
+  size_t len;
+  /** The value of a TOKEN_INT/TOKEN_DOUBLE or the atom of a TOKEN_VAR,
+   * made once by the lexer */
+  union {
+    /** The value of a TOKEN_INT */
+    long long int_value;
+    /** The value of a TOKEN_DOUBLE */
+    double double_value;
+    /** The interned name of a TOKEN_VAR */
+    const atom * atom_value;
+  } value;
   /** The type of the token */
   token_type type;
 } token;
 
-token * init_token(char * t_literal, token_type type);
-void token_dump_debug(token * t);
-void free_token(token * t);
+token init_token(const char * t_literal, size_t len, token_type type);
+int token_equals(token t, const char * literal);
+void token_dump_debug(token t);
 
 #endif
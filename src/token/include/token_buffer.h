@@ -0,0 +1,42 @@
+/**
+ * @file   token_buffer.h
+ * @brief  this file contains the function definitions for token_buffer.c
+ * @author Matthew C. Lindeman
+ * @date   September 17, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef TOKB_H
+#define TOKB_H
+
+#include <stdlib.h>
+#include "token.h"
+
+/** The token under the cursor of a token_buffer */
+#define CURRENT_TOKEN(tb) ((tb)->tokens[(tb)->cursor])
+
+/**
+ * This structure is a growable array of tokens in source order that the
+ * parser reads front to back with a cursor.  It is meant to be cleared and
+ * reused for every line so that it only allocates while it grows.
+ */
+typedef struct TOKEN_BUFFER_T {
+  /** The tokens in the order they were lexed */
+  token * tokens;
+  /** The number of tokens in the buffer */
+  size_t qty_tokens;
+  /** The number of tokens the buffer has room for */
+  size_t cap_tokens;
+  /** The index of the next token to be parsed */
+  size_t cursor;
+} token_buffer;
+
+token_buffer * init_token_buffer(void);
+void push_token(token_buffer * tb, token t);
+void advance_token(token_buffer * tb);
+int has_token(token_buffer * tb);
+void clear_token_buffer(token_buffer * tb);
+void token_buffer_dump_debug(token_buffer * tb);
+void free_token_buffer(token_buffer * tb);
+
+#endif
@@ -6,53 +6,43 @@
  * @bug    None known
  * @todo   Nothing
  */
-#define _POSIX_C_SOURCE 200809L
 #include "include/token.h"
 
 /**
- * This function initializes a token
+ * This function initializes a token (no memory is allocated, the token
+ * refers to t_literal).
  * @param t_literal - the token literal as represented by a string
+ * @param       len - the length of the literal
  * @param      type - the token type
  * @return        t - the new token
  */
-token * init_token(char * t_literal, token_type type) { 
-  token * t = calloc(1, sizeof(struct TOKEN_T));
-  size_t len = (strnlen(t_literal, MAX_TOK_LEN) + 1);
-  t->t_literal = calloc(len, sizeof(char));
-  strncpy(t->t_literal, t_literal, len);
-  t->type = type;
+token init_token(const char * t_literal, size_t len, token_type type) {
+  token t = {0};
+  t.t_literal = t_literal;
+  t.len = len;
+  t.type = type;
   return t;
 }
 
 /**
- * This function dumps the debugging info for a token (i.e. prints it and all
- * related values).
- * @param    t - the token to be debugged
- * @return N/a
+ * This function determines if the literal of a token is literal.
+ * @param       t - the token
+ * @param literal - the NUL terminated string to compare against
+ * @return     .\ - 1 if they are the same, 0 otherwise
  */
-void token_dump_debug(token * t) {
-  if(t) {
-    printf("Token:\n");
-    if(t->t_literal)
-      printf("t_literal: `%s` ", t->t_literal);
-    printf("type: `%s`\n", token_type_to_string(t->type));
-  } else {
-    fprintf(stderr, "[TOKEN DUMP DEBUG]: uninitialized token sent to debug."
-        "\nExiting.\n");
-    exit(1);
-  }
-  printf("--\n");
+int token_equals(token t, const char * literal) {
+  return strlen(literal) == t.len && !memcmp(t.t_literal, literal, t.len);
 }
 
 /**
- * This function frees a given token
- * @param    t - the token to be freed
+ * This function dumps the debugging info for a token (i.e. prints it and all
+ * related values).
+ * @param    t - the token to be debugged
  * @return N/a
  */
-void free_token(token * t) {
-  if(t) {
-    if(t->t_literal)
-      free(t->t_literal);
-    free(t);
-  }
+void token_dump_debug(token t) {
+  printf("Token:\n");
+  printf("t_literal: `%.*s` ", (int)t.len, t.t_literal);
+  printf("type: `%s`\n", token_type_to_string(t.type));
+  printf("--\n");
 }
@@ -0,0 +1,93 @@
+/**
+ * @file   token_buffer.c
+ * @brief  this file contains the functions that relate to a token_buffer.
+ * @author Matthew C. Lindeman
+ * @date   September 17, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/token_buffer.h"
+
+/**
+ * This function initializes an empty token_buffer.
+ * @param N/a
+ * @return tb - the new token_buffer
+ */
+token_buffer * init_token_buffer(void) {
+  token_buffer * tb = calloc(1, sizeof(struct TOKEN_BUFFER_T));
+  tb->tokens = NULL;
+  tb->qty_tokens = 0;
+  tb->cap_tokens = 0;
+  tb->cursor = 0;
+  return tb;
+}
+
+/**
+ * This function appends a token to the buffer (growing it geometrically).
+ * @param tb - the token_buffer to be appended to
+ * @param  t - the token
+ * @return N/a
+ */
+void push_token(token_buffer * tb, token t) {
+  if(tb->qty_tokens == tb->cap_tokens) {
+    tb->cap_tokens = tb->cap_tokens ? 2 * tb->cap_tokens : 16;
+    tb->tokens = realloc(tb->tokens, tb->cap_tokens * sizeof(struct TOKEN_T));
+  }
+  tb->tokens[tb->qty_tokens++] = t;
+}
+
+/**
+ * This function moves the cursor to the next token.  The cursor never moves
+ * past the last token (a newline) so the parser can always look at it.
+ * @param tb - the token_buffer
+ * @return N/a
+ */
+void advance_token(token_buffer * tb) {
+  if(tb->cursor + 1 < tb->qty_tokens)
+    tb->cursor++;
+}
+
+/**
+ * This function determines if the buffer holds any token to be parsed.
+ * @param tb - the token_buffer
+ * @return .\ - 1 if there is a token under the cursor, 0 otherwise
+ */
+int has_token(token_buffer * tb) {
+  return tb->cursor < tb->qty_tokens;
+}
+
+/**
+ * This function empties the buffer (keeping its memory for reuse).
+ * @param tb - the token_buffer to be cleared
+ * @return N/a
+ */
+void clear_token_buffer(token_buffer * tb) {
+  tb->qty_tokens = 0;
+  tb->cursor = 0;
+}
+
+/**
+ * This function prints the debugging information relating to the given token
+ * buffer
+ * @param   tb - the token buffer to be debugged
+ * @return N/a
+ */
+void token_buffer_dump_debug(token_buffer * tb) {
+  printf("Token Buffer (cursor %zu):\n", tb->cursor);
+  for(size_t i = 0; i < tb->qty_tokens; i++)
+    token_dump_debug(tb->tokens[i]);
+  printf("--\n");
+}
+
+/**
+ * This function frees a token_buffer.
+ * @param tb - the token_buffer to be freed
+ * @return N/a
+ */
+void free_token_buffer(token_buffer * tb) {
+  if(tb) {
+    if(tb->tokens)
+      free(tb->tokens);
+    free(tb);
+  }
+}
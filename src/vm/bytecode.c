@@ -0,0 +1,213 @@
+/**
+ * @file   bytecode.c
+ * @brief  This file contains the functions that lower an abstract syntax tree
+ * into a chunk of bytecode for the vm.
+ * @author Matthew C. Lindeman
+ * @date   September 03, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/bytecode.h"
+
+/**
+ * This function initializes an empty chunk with room for a tree of qty_nodes
+ * nodes.  Every node emits at most one instruction and constant, so the chunk
+ * never has to grow.
+ * @param         a - The arena the chunk is allocated from.
+ * @param qty_nodes - The number of nodes in the tree to be compiled.
+ * @return       ch - The new chunk.
+ */
+chunk * init_chunk(arena * a, int qty_nodes) {
+  chunk * ch = arena_alloc(a, sizeof(struct CHUNK_T));
+  ch->code = arena_alloc(a, (qty_nodes + 1) * sizeof(struct INSTRUCTION_T));
+  ch->constants = arena_alloc(a, qty_nodes * sizeof(struct AST_RESULT_T));
+  ch->qty_code = 0;
+  ch->qty_constants = 0;
+  ch->max_stack = 0;
+  return ch;
+}
+
+/**
+ * This function compiles an abstract syntax tree into a chunk.  The tree is
+ * flattened first: a flat_ast is already in post order, so the chunk is
+ * emitted in one pass over its arrays with an instruction per node.  The
+ * chunk lives in the arena and is released with it.  The variables of the
+ * tree must have been resolved (see resolve_tree).
+ * @param abstree - The abstract syntax tree to be compiled.
+ * @param       a - The arena the chunk is allocated from.
+ * @return     ch - The chunk that evaluates abstree.
+ */
+chunk * compile_tree(ast * abstree, arena * a) {
+  flat_ast * fa = flatten_tree(abstree, a);
+  chunk * ch = init_chunk(a, fa->qty_nodes);
+  int depth = 0;
+  for(int i = 0; i < fa->qty_nodes; i++)
+    depth = compile_node(ch, a, fa, i, depth);
+  emit_instruction(ch, OP_RETURN, 0, 1);
+  return ch;
+}
+
+/**
+ * This function emits the instruction of a node of a flat_ast (the code of
+ * its children has already been emitted).
+ * @param    ch - The chunk being compiled into.
+ * @param     a - The arena the chunk is allocated from.
+ * @param    fa - The flat_ast being compiled.
+ * @param     i - The index of the node.
+ * @param depth - The stack depth before the node runs.
+ * @return    .\ - The stack depth once the node has run.
+ */
+int compile_node(chunk * ch, arena * a, flat_ast * fa, int i, int depth) {
+  flat_payload * p = &fa->payloads[i];
+  opcode op = OP_RETURN;
+  switch(fa->types[i]) {
+    case TOKEN_VAR:
+      emit_instruction(ch, OP_LOAD_SLOT, compile_slot(p), depth + 1);
+      return depth + 1;
+    case TOKEN_INT:
+      emit_instruction(ch, OP_CONSTANT, add_constant(ch,
+            int_ast_result(p->int_value)), depth + 1);
+      return depth + 1;
+    case TOKEN_DOUBLE:
+      emit_instruction(ch, OP_CONSTANT, add_constant(ch,
+            double_ast_result(p->double_value)), depth + 1);
+      return depth + 1;
+    case TOKEN_STRING:
+      emit_instruction(ch, OP_CONSTANT, add_constant(ch,
+            string_ast_result(arena_shared_string(a, p->name.literal,
+                p->name.len))), depth + 1);
+      return depth + 1;
+    case TOKEN_ASSIGN:
+      emit_instruction(ch, OP_STORE_SLOT, compile_slot(p), depth);
+      return depth;
+    case TOKEN_PLUS:
+    case TOKEN_MINUS:
+    case TOKEN_MULT:
+    case TOKEN_DIV:
+      op = arithmetic_opcode(fa, i);
+      break;
+    case TOKEN_POWER:    op = OP_POW;      break;
+    case TOKEN_EQUALITY: op = OP_EQUALITY; break;
+    case TOKEN_GT_EQ:    op = OP_GT_EQ;    break;
+    case TOKEN_GT:       op = OP_GT;       break;
+    case TOKEN_LT_EQ:    op = OP_LT_EQ;    break;
+    case TOKEN_LT:       op = OP_LT;       break;
+    case TOKEN_SIN:      op = OP_SIN;      break;
+    case TOKEN_COS:      op = OP_COS;      break;
+    case TOKEN_TAN:      op = OP_TAN;      break;
+    case TOKEN_ARC_SIN:  op = OP_ARC_SIN;  break;
+    case TOKEN_ARC_COS:  op = OP_ARC_COS;  break;
+    case TOKEN_ARC_TAN:  op = OP_ARC_TAN;  break;
+    case TOKEN_LOG:      op = OP_LOG;      break;
+    default:
+      fprintf(stderr, "[COMPILE_NODE]: Unhandled Token: `%s`\nExiting\n",
+          token_type_to_string(fa->types[i]));
+      exit(1);
+  }
+  // A binary operator pops both operands and pushes its value, a function
+  // replaces its operand
+  if(fa->rhs[i] != -1)
+    depth--;
+  emit_instruction(ch, op, 0, depth);
+  return depth;
+}
+
+/**
+ * This function gives the opcode of an arithmetic node: the one for its
+ * operand types if the type checker found them the same, the checked one
+ * otherwise (mixed operands are promoted by the kernel table).
+ * @param fa - The flat_ast the node is in.
+ * @param  i - The index of the node (+, -, * or /).
+ * @return op - The opcode.
+ */
+opcode arithmetic_opcode(flat_ast * fa, int i) {
+  int is_same = fa->kernels[i]
+    && fa->value_types[fa->lhs[i]] == fa->value_types[fa->rhs[i]];
+  int is_int = is_same && fa->value_types[i] == INT;
+  int is_double = is_same && fa->value_types[i] == DOUBLE;
+  switch(fa->types[i]) {
+    case TOKEN_PLUS:
+      return is_int ? OP_ADD_II : is_double ? OP_ADD_DD : OP_ADD;
+    case TOKEN_MINUS:
+      return is_int ? OP_SUB_II : is_double ? OP_SUB_DD : OP_SUB;
+    case TOKEN_MULT:
+      return is_int ? OP_MUL_II : is_double ? OP_MUL_DD : OP_MUL;
+    default:
+      return is_int ? OP_DIV_II : is_double ? OP_DIV_DD : OP_DIV;
+  }
+}
+
+/**
+ * This function gives the slot of a resolved TOKEN_VAR/TOKEN_ASSIGN node.
+ * @param p - The payload of the node.
+ * @return .\ - The slot of the node.
+ */
+int compile_slot(flat_payload * p) {
+  if(p->name.slot == -1) {
+    fprintf(stderr, "[COMPILE_SLOT]: Unresolved variable `%.*s`\nExiting\n",
+        (int)p->name.len, p->name.literal);
+    exit(1);
+  }
+  return p->name.slot;
+}
+
+/**
+ * This function appends an instruction to a chunk.
+ * @param      ch - The chunk to be appended to.
+ * @param      op - The opcode of the instruction.
+ * @param operand - The operand of the instruction.
+ * @param   depth - The stack depth once the instruction has run.
+ * @return    N/a
+ */
+void emit_instruction(chunk * ch, opcode op, int operand, int depth) {
+  ch->qty_code++;
+  ch->code[ch->qty_code - 1].op = op;
+  ch->code[ch->qty_code - 1].operand = operand;
+  if(depth > ch->max_stack)
+    ch->max_stack = depth;
+}
+
+/**
+ * This function adds a constant to the constant pool of a chunk.
+ * @param    ch - The chunk the constant belongs to.
+ * @param value - The constant (its string must outlive the chunk).
+ * @return   .\ - The index of the constant.
+ */
+int add_constant(chunk * ch, ast_result value) {
+  ch->qty_constants++;
+  ch->constants[ch->qty_constants - 1] = value;
+  return ch->qty_constants - 1;
+}
+
+/**
+ * This function is used for debugging chunks.
+ * @param ch - The chunk to be debugged.
+ * @return N/a
+ */
+void chunk_dump_debug(chunk * ch) {
+  char * buf = NULL;
+  size_t size = 0;
+  printf("Chunk\n");
+  for(int i = 0; i < ch->qty_code; i++) {
+    printf("%04d %-14s", i, opcode_to_string(ch->code[i].op));
+    switch(ch->code[i].op) {
+      case OP_CONSTANT:
+        size = ast_result_format(ch->constants[ch->code[i].operand], NULL, 0)
+          + 1;
+        buf = calloc(size, sizeof(char));
+        ast_result_format(ch->constants[ch->code[i].operand], buf, size);
+        printf(" %s", buf);
+        free(buf);
+        break;
+      case OP_LOAD_SLOT:
+      case OP_STORE_SLOT:
+        printf(" %d", ch->code[i].operand);
+        break;
+      default:
+        break;
+    }
+    printf("\n");
+  }
+  printf("Max Stack: %d\n", ch->max_stack);
+  printf("--\n");
+}
@@ -0,0 +1,56 @@
+/**
+ * @file   bytecode.h
+ * @brief  This file contains the function definitions for bytecode.c
+ * @author Matthew C. Lindeman
+ * @date   September 03, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef BYC_H
+#define BYC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "opcode.h"
+#include "../../parser/include/flat_ast.h"
+
+/**
+ * This structure is a single instruction of the vm.
+ */
+typedef struct INSTRUCTION_T {
+  /** The operation to be performed */
+  opcode op;
+  /** The index into the constants or the frame slot (if any) */
+  int operand;
+} instruction;
+
+/**
+ * This structure is the compiled form of an abstract syntax tree.  The code is
+ * laid out in post order so the vm only ever walks it front to back.  A chunk
+ * is allocated from the same arena as the tree it was compiled from, and it
+ * refers to variables by the frame slots the tree was resolved to.
+ */
+typedef struct CHUNK_T {
+  /** The instructions of the chunk */
+  instruction * code;
+  /** The constants referenced by OP_CONSTANT */
+  ast_result * constants;
+  /** The number of instructions in the chunk */
+  int qty_code;
+  /** The number of constants in the chunk */
+  int qty_constants;
+  /** The deepest the value stack gets while running the chunk */
+  int max_stack;
+} chunk;
+
+chunk * init_chunk(arena * a, int qty_nodes);
+chunk * compile_tree(ast * abstree, arena * a);
+int compile_node(chunk * ch, arena * a, flat_ast * fa, int i, int depth);
+opcode arithmetic_opcode(flat_ast * fa, int i);
+int compile_slot(flat_payload * p);
+void emit_instruction(chunk * ch, opcode op, int operand, int depth);
+int add_constant(chunk * ch, ast_result value);
+void chunk_dump_debug(chunk * ch);
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file   opcode.h
+ * @brief  This file contains the function definitions for opcode.c
+ * @author Matthew C. Lindeman
+ * @date   September 03, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef OPC_H
+#define OPC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * This enumeration is the instruction set of the ao virtual machine.  Every
+ * instruction works on the top of the value stack of the vm.
+ */
+typedef enum {
+  /** Push constants[operand] */
+  OP_CONSTANT,
+  /** Push the value of the variable in frame slot operand */
+  OP_LOAD_SLOT,
+  /** Pop a value and assign it to frame slot operand, push the int 1 */
+  OP_STORE_SLOT,
+  OP_ADD,
+  OP_SUB,
+  OP_MUL,
+  OP_DIV,
+  OP_POW,
+  OP_EQUALITY,
+  OP_GT_EQ,
+  OP_GT,
+  OP_LT_EQ,
+  OP_LT,
+  OP_SIN,
+  OP_COS,
+  OP_TAN,
+  OP_ARC_SIN,
+  OP_ARC_COS,
+  OP_ARC_TAN,
+  OP_LOG,
+  /** The arithmetic of two INTs (the types are known when compiling) */
+  OP_ADD_II,
+  OP_SUB_II,
+  OP_MUL_II,
+  OP_DIV_II,
+  /** The arithmetic of two DOUBLEs (the types are known when compiling) */
+  OP_ADD_DD,
+  OP_SUB_DD,
+  OP_MUL_DD,
+  OP_DIV_DD,
+  /** Stop execution, the top of the stack is the result */
+  OP_RETURN
+} opcode;
+
+const char * opcode_to_string(opcode op);
+
+#endif
@@ -0,0 +1,35 @@
+/**
+ * @file   vm.h
+ * @brief  This file contains the function definitions for vm.c
+ * @author Matthew C. Lindeman
+ * @date   September 03, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef VM_H
+#define VM_H
+
+#include <math.h>
+#include "bytecode.h"
+
+/**
+ * This structure is the stack machine that runs chunks.  The value stack is
+ * kept between runs so that steady state evaluation does not allocate.
+ */
+typedef struct VM_T {
+  /** The value stack */
+  ast_result * stack;
+  /** The number of values the stack can hold */
+  int stack_size;
+  /** The index of the next free slot on the stack */
+  int sp;
+} vm;
+
+vm * init_vm(void);
+ast_result run_chunk(vm * v, chunk * ch, symbol_table ** st);
+ast_result vm_binary_op(opcode op, ast_result lhs, ast_result rhs);
+ast_result vm_unary_op(opcode op, ast_result operand);
+ast_result vm_load_slot(symbol_table * st, int slot);
+void free_vm(vm * v);
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file   opcode.c
+ * @brief  This file contains the related functions for the opcode enumeration.
+ * @author Matthew C. Lindeman
+ * @date   September 03, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/opcode.h"
+
+/**
+ * This function takes an opcode and converts it to a const char *
+ * representation.
+ * @param op - The opcode in question.
+ * @return .\ - The corresponding const char *.
+ */
+const char * opcode_to_string(opcode op) {
+  switch(op) {
+    case OP_CONSTANT:  return "Op Constant";
+    case OP_LOAD_SLOT:  return "Op Load Slot";
+    case OP_STORE_SLOT: return "Op Store Slot";
+    case OP_ADD:       return "Op Add";
+    case OP_SUB:       return "Op Sub";
+    case OP_MUL:       return "Op Mul";
+    case OP_DIV:       return "Op Div";
+    case OP_POW:       return "Op Pow";
+    case OP_EQUALITY:  return "Op Equality";
+    case OP_GT_EQ:     return "Op Gt Eq";
+    case OP_GT:        return "Op Gt";
+    case OP_LT_EQ:     return "Op Lt Eq";
+    case OP_LT:        return "Op Lt";
+    case OP_SIN:       return "Op Sin";
+    case OP_COS:       return "Op Cos";
+    case OP_TAN:       return "Op Tan";
+    case OP_ARC_SIN:   return "Op Arc Sin";
+    case OP_ARC_COS:   return "Op Arc Cos";
+    case OP_ARC_TAN:   return "Op Arc Tan";
+    case OP_LOG:       return "Op Log";
+    case OP_ADD_II:    return "Op Add Ii";
+    case OP_SUB_II:    return "Op Sub Ii";
+    case OP_MUL_II:    return "Op Mul Ii";
+    case OP_DIV_II:    return "Op Div Ii";
+    case OP_ADD_DD:    return "Op Add Dd";
+    case OP_SUB_DD:    return "Op Sub Dd";
+    case OP_MUL_DD:    return "Op Mul Dd";
+    case OP_DIV_DD:    return "Op Div Dd";
+    case OP_RETURN:    return "Op Return";
+  }
+  fprintf(stderr, "[OPCODE_TO_STRING]: Fell Through\nExiting\n");
+  exit(1);
+}
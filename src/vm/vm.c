@@ -0,0 +1,197 @@
+/**
+ * @file   vm.c
+ * @brief  This file contains the functions that run a chunk of bytecode over a
+ * value stack.
+ * @author Matthew C. Lindeman
+ * @date   September 03, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "include/vm.h"
+
+/**
+ * This function initializes a vm with an empty stack.
+ * @param N/a
+ * @return v - The new vm.
+ */
+vm * init_vm(void) {
+  vm * v = calloc(1, sizeof(struct VM_T));
+  v->stack = NULL;
+  v->stack_size = 0;
+  v->sp = 0;
+  return v;
+}
+
+/**
+ * This function runs a chunk to completion.
+ * @param  v - The vm to run the chunk on.
+ * @param ch - The chunk to be run.
+ * @param st - The stack frame for the chunk.
+ * @return .\ - The value left on top of the stack (owned by the caller).
+ */
+ast_result run_chunk(vm * v, chunk * ch, symbol_table ** st) {
+  ast_result rhs = {0};
+  if(ch->max_stack > v->stack_size) {
+    v->stack_size = ch->max_stack;
+    v->stack = realloc(v->stack, v->stack_size * sizeof(struct AST_RESULT_T));
+  }
+  v->sp = 0;
+  for(instruction * ip = ch->code; ; ip++) {
+    switch(ip->op) {
+      case OP_CONSTANT:
+        v->stack[v->sp++] = copy_ast_result(ch->constants[ip->operand]);
+        break;
+      case OP_LOAD_SLOT:
+        v->stack[v->sp++] = vm_load_slot(st[0], ip->operand);
+        break;
+      case OP_STORE_SLOT:
+        v->stack[v->sp - 1] = ast_result_assign_slot(ip->operand,
+            v->stack[v->sp - 1], st);
+        break;
+      case OP_ADD:
+      case OP_SUB:
+      case OP_MUL:
+      case OP_DIV:
+      case OP_POW:
+      case OP_EQUALITY:
+      case OP_GT_EQ:
+      case OP_GT:
+      case OP_LT_EQ:
+      case OP_LT:
+        rhs = v->stack[--v->sp];
+        v->stack[v->sp - 1] = vm_binary_op(ip->op, v->stack[v->sp - 1], rhs);
+        break;
+      case OP_SIN:
+      case OP_COS:
+      case OP_TAN:
+      case OP_ARC_SIN:
+      case OP_ARC_COS:
+      case OP_ARC_TAN:
+      case OP_LOG:
+        v->stack[v->sp - 1] = vm_unary_op(ip->op, v->stack[v->sp - 1]);
+        break;
+      case OP_ADD_II:
+        v->sp--;
+        v->stack[v->sp - 1].value.int_value
+          = int_add(v->stack[v->sp - 1].value.int_value,
+              v->stack[v->sp].value.int_value);
+        break;
+      case OP_SUB_II:
+        v->sp--;
+        v->stack[v->sp - 1].value.int_value
+          = int_sub(v->stack[v->sp - 1].value.int_value,
+              v->stack[v->sp].value.int_value);
+        break;
+      case OP_MUL_II:
+        v->sp--;
+        v->stack[v->sp - 1].value.int_value
+          = int_mul(v->stack[v->sp - 1].value.int_value,
+              v->stack[v->sp].value.int_value);
+        break;
+      case OP_DIV_II:
+        rhs = v->stack[--v->sp];
+        v->stack[v->sp - 1] = ast_result_div_ii(v->stack[v->sp - 1], rhs);
+        break;
+      case OP_ADD_DD:
+        v->sp--;
+        v->stack[v->sp - 1].value.double_value
+          += v->stack[v->sp].value.double_value;
+        break;
+      case OP_SUB_DD:
+        v->sp--;
+        v->stack[v->sp - 1].value.double_value
+          -= v->stack[v->sp].value.double_value;
+        break;
+      case OP_MUL_DD:
+        v->sp--;
+        v->stack[v->sp - 1].value.double_value
+          *= v->stack[v->sp].value.double_value;
+        break;
+      case OP_DIV_DD:
+        v->sp--;
+        v->stack[v->sp - 1].value.double_value
+          /= v->stack[v->sp].value.double_value;
+        break;
+      case OP_RETURN:
+        return v->stack[--v->sp];
+    }
+  }
+}
+
+/**
+ * This function applies a binary operator to two values.  Note: like the
+ * ast_result family of functions it frees each argument.
+ * @param  op - The operator.
+ * @param lhs - The left hand side of the operator.
+ * @param rhs - The right hand side of the operator.
+ * @return .\ - The result of the operation.
+ */
+ast_result vm_binary_op(opcode op, ast_result lhs, ast_result rhs) {
+  switch(op) {
+    case OP_ADD:      return ast_result_binary(BINARY_ADD, lhs, rhs);
+    case OP_SUB:      return ast_result_binary(BINARY_SUB, lhs, rhs);
+    case OP_MUL:      return ast_result_binary(BINARY_MUL, lhs, rhs);
+    case OP_DIV:      return ast_result_binary(BINARY_DIV, lhs, rhs);
+    case OP_POW:      return ast_result_binary(BINARY_POW, lhs, rhs);
+    case OP_EQUALITY: return ast_result_binary(BINARY_EQ, lhs, rhs);
+    case OP_GT_EQ:    return ast_result_binary(BINARY_GT_EQ, lhs, rhs);
+    case OP_GT:       return ast_result_binary(BINARY_GT, lhs, rhs);
+    case OP_LT_EQ:    return ast_result_binary(BINARY_LT_EQ, lhs, rhs);
+    case OP_LT:       return ast_result_binary(BINARY_LT, lhs, rhs);
+    default:
+      fprintf(stderr, "[VM_BINARY_OP]: Not a Binary Operator: `%s`\n"
+          "Exiting\n", opcode_to_string(op));
+      exit(1);
+  }
+}
+
+/**
+ * This function applies a unary operator (i.e. the trig/log family) to a
+ * value.
+ * @param      op - The operator.
+ * @param operand - The operand of the operator.
+ * @return     .\ - The result of the operation.
+ */
+ast_result vm_unary_op(opcode op, ast_result operand) {
+  switch(op) {
+    case OP_SIN:     return ast_result_unary(UNARY_SIN, operand);
+    case OP_COS:     return ast_result_unary(UNARY_COS, operand);
+    case OP_TAN:     return ast_result_unary(UNARY_TAN, operand);
+    case OP_ARC_SIN: return ast_result_unary(UNARY_ARC_SIN, operand);
+    case OP_ARC_COS: return ast_result_unary(UNARY_ARC_COS, operand);
+    case OP_ARC_TAN: return ast_result_unary(UNARY_ARC_TAN, operand);
+    case OP_LOG:     return ast_result_unary(UNARY_LOG, operand);
+    default:
+      fprintf(stderr, "[VM_UNARY_OP]: Not a Unary Operator: `%s`\n"
+          "Exiting\n", opcode_to_string(op));
+      exit(1);
+  }
+}
+
+/**
+ * This function reads a variable from a slot of the symbol_table.
+ * @param   st - The symbol_table containing the variable.
+ * @param slot - The slot of the variable.
+ * @return  .\ - The value of the variable.
+ */
+ast_result vm_load_slot(symbol_table * st, int slot) {
+  if(!st->udv[slot]->is_set) {
+    fprintf(stderr, "[VM_LOAD_SLOT]: Variable `%s` not found.\nExiting\n",
+        st->udv[slot]->name->name);
+    exit(1);
+  }
+  return init_ast_result_from_variable(st->udv[slot]);
+}
+
+/**
+ * This function frees a vm.
+ * @param v - The vm to be freed.
+ * @return N/a
+ */
+void free_vm(vm * v) {
+  if(v) {
+    if(v->stack)
+      free(v->stack);
+    free(v);
+  }
+}
@@ -0,0 +1,164 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../../src/aot/include/aot.h"
+#include "../../src/console/include/source_file.h"
+#include "../common/engine_check.h"
+
+/** The number of lines of the generated corpus */
+#define CORPUS_LINES 300
+
+/**
+ * This function removes a cache directory and the shared objects in it.
+ * @param dir - The directory.
+ * @return N/a
+ */
+void remove_cache(const char * dir) {
+  char path[512];
+  DIR * d = opendir(dir);
+  struct dirent * entry = NULL;
+  while(d && (entry = readdir(d))) {
+    if(entry->d_name[0] == '.')
+      continue;
+    snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+    remove(path);
+  }
+  if(d)
+    closedir(d);
+  rmdir(dir);
+}
+
+/**
+ * This function runs a statement interpreted (e = 0) or compiled (e = 1).
+ * @param prog - The program.
+ * @param    e - The engine.
+ * @param    i - The index of the statement.
+ * @param   st - The variables.
+ * @param data - The compiled module of the program.
+ * @return  .\ - The value of the statement.
+ */
+ast_result run_aot(program * prog, int e, int i, symbol_table ** st,
+    void * data) {
+  aot_module * m = data;
+  if(!e)
+    return evaluate_tree(prog->statements[i].abstree, st);
+  return m->lines[i](&AOT_HOST, st);
+}
+
+/**
+ * This function compiles a script ahead of time, checks that compiling it
+ * again finds it in the cache, and checks that every statement has the same
+ * value compiled and interpreted.
+ * @param       src - The script.
+ * @param       len - The length of the script.
+ * @param cache_dir - The directory compiled scripts are cached in.
+ * @return      N/a
+ */
+void aot_cross_check(const char * src, size_t len, const char * cache_dir) {
+  options opts = {.simplify = 1, .repeat = 1, .eng = ENGINE_TREE, .aot = 1};
+  const char * names[2] = {"interpreted", "compiled"};
+  program * prog = parse_script(src, len, &opts);
+  program * progs[2] = {prog, prog};
+  aot_module * m = aot_compile(prog, cache_dir);
+  assert(m && !m->was_cached && m->qty_lines == prog->qty_statements);
+  free_aot_module(m);
+  m = aot_compile(prog, cache_dir);
+  assert(m && m->was_cached);
+  cross_check(progs, names, 2, 1, run_aot, m);
+  free_aot_module(m);
+  free_program(prog);
+}
+
+/**
+ * This function tests the translation of literals: every DOUBLE keeps its
+ * exact bits and the bytes of STRINGs are escaped.
+ * @param  N/a
+ * @return N/a
+ */
+void aot_translate_test(void) {
+  const char * src = "x = 0.1\n\"a'b\"\n";
+  options opts = {.repeat = 1, .eng = ENGINE_TREE, .aot = 1};
+  run_stats rs = {0};
+  program * prog = init_program();
+  aot_buffer out = {0};
+  out.cap = AOT_INITIAL_TEXT;
+  out.text = malloc(out.cap);
+  parse_program(prog, src, strlen(src), &opts, &rs);
+  assert(aot_translate(prog, &out) && strlen(out.text) == out.len);
+  assert(strstr(out.text, "ao_bits(0x3fb999999999999aULL)"));
+  assert(strstr(out.text, "h->assign(0, t0, st)"));
+  assert(strstr(out.text, "h->string(\"\\141\\047\\142\", 3)"));
+  assert(strstr(out.text, "ao_line_1,\n  NULL\n};"));
+  free(out.text);
+  free_program(prog);
+}
+
+/**
+ * This function tests that only a cache the user alone can write to is used:
+ * there is no shared default directory, and a directory or shared object
+ * others can write to is not loaded from.
+ * @param cache_dir - A private directory for compiled scripts.
+ * @return      N/a
+ */
+void aot_cache_test(const char * cache_dir) {
+  const char * names[] = {"AO_CACHE_DIR", "XDG_CACHE_HOME", "HOME"};
+  const char * src = "x = 1\nx + 1\n";
+  char * saved[3];
+  char so_path[512] = "";
+  options opts = {.repeat = 1, .eng = ENGINE_TREE, .aot = 1};
+  run_stats rs = {0};
+  program * prog = init_program();
+  aot_module * m = NULL;
+  DIR * d = NULL;
+  struct dirent * entry = NULL;
+  for(int i = 0; i < 3; i++) {
+    saved[i] = getenv(names[i]) ? strdup(getenv(names[i])) : NULL;
+    unsetenv(names[i]);
+  }
+  assert(!aot_cache_dir());
+  for(int i = 0; i < 3; i++) {
+    if(saved[i])
+      setenv(names[i], saved[i], 1);
+    free(saved[i]);
+  }
+  parse_program(prog, src, strlen(src), &opts, &rs);
+  chmod(cache_dir, 0777);
+  assert(!aot_compile(prog, cache_dir));
+  chmod(cache_dir, 0700);
+  m = aot_compile(prog, cache_dir);
+  assert(m && aot_is_private(cache_dir, 1));
+  free_aot_module(m);
+  d = opendir(cache_dir);
+  while((entry = readdir(d)))
+    if(strstr(entry->d_name, ".so"))
+      snprintf(so_path, sizeof(so_path), "%s/%s", cache_dir, entry->d_name);
+  closedir(d);
+  assert(aot_is_private(so_path, 0));
+  chmod(so_path, 0766);
+  assert(!aot_is_private(so_path, 0) && !aot_open(so_path, 2));
+  free_program(prog);
+}
+
+int main(void) {
+  char cache_dir[] = "/tmp/ao_test_XXXXXX";
+  size_t len = 0;
+  char * corpus = NULL;
+  source_file * sf = load_source_file("docs/phase1.ao");
+  assert(mkdtemp(cache_dir));
+  seed = 777;
+  corpus = generate_corpus(CORPUS_LINES, &len);
+  aot_translate_test();
+  aot_cache_test(cache_dir);
+  aot_cross_check(INT_EDGES, strlen(INT_EDGES), cache_dir);
+  aot_cross_check(sf->src, sf->len, cache_dir);
+  aot_cross_check(corpus, len, cache_dir);
+  remove_cache(cache_dir);
+  free_source_file(sf);
+  free(corpus);
+  free_intern_table();
+  printf("aot_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/arena/include/arena.h"
+#include "../../src/lexer/include/lexer.h"
+#include "../../src/parser/include/parser.h"
+#include "../../src/vm/include/bytecode.h"
+
+/**
+ * This function tests that arena allocations are aligned, zeroed and reused
+ * after a reset.
+ * @param  N/a
+ * @return N/a
+ */
+void arena_test(void) {
+  arena * a = init_arena();
+  char * s = arena_strndup(a, "hello world", 5);
+  long long * n = arena_alloc(a, sizeof(long long));
+  assert(!strcmp(s, "hello"));
+  assert(((size_t)n % ARENA_ALIGN) == 0 && *n == 0);
+  assert(a->qty_allocs == 2 && a->qty_mallocs == 0);
+  arena_alloc(a, 4 * ARENA_BLOCK_SIZE);
+  assert(a->qty_mallocs == 1);
+  reset_arena(a);
+  assert(arena_alloc(a, 1) == s);
+  arena_alloc(a, 4 * ARENA_BLOCK_SIZE);
+  assert(a->qty_mallocs == 0 && a->total_mallocs == 2);
+  free_arena(a);
+}
+
+/**
+ * This function tests that once the arena has grown to fit a statement,
+ * parsing and compiling that statement again does not call malloc.
+ * @param  N/a
+ * @return N/a
+ */
+void arena_statement_test(void) {
+  const char * src = "x = (1 + 2) * sin(3.5) - y ^ 2 == \"str\"\n";
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  symbol_table * st = init_symbol_table();
+  lexer * lex = NULL;
+  ast * abstree = NULL;
+  chunk * ch = NULL;
+  for(int i = 0; i < 100; i++) {
+    lex = init_lexer(src, strlen(src));
+    lex_source(lex, tb);
+    abstree = parse_expression(tb, a);
+    resolve_tree(abstree, st);
+    ch = compile_tree(abstree, a);
+    assert(ch->qty_code > 0);
+    if(i > 0)
+      assert(a->qty_mallocs == 0);
+    reset_arena(a);
+    free_lexer(lex);
+  }
+  assert(a->total_mallocs == 1);
+  free_symbol_table(st);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+int main(void) {
+  arena_test();
+  arena_statement_test();
+  printf("arena_test: passed\n");
+  return 0;
+}
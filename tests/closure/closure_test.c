@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/console/include/source_file.h"
+#include "../common/engine_check.h"
+
+/** The number of lines of the generated corpus */
+#define CORPUS_LINES 4000
+
+/** A script whose operands assign the variables their siblings read (so the
+ * engines must all evaluate operands left to right) */
+#define OPERAND_ASSIGNS "x = 1.5\n(x = 2) + x\nx * (x = 3)\n(x = 4) - x\n"
+
+/**
+ * This function runs a script with the tree walker, the vm and the closures
+ * and checks that every statement has the same value with all three.
+ * @param src - The script.
+ * @param len - The length of the script.
+ * @return N/a
+ */
+void closure_cross_check(const char * src, size_t len) {
+  engine engines[3] = {ENGINE_TREE, ENGINE_VM, ENGINE_CLOSURE};
+  const char * names[3] = {"tree", "vm", "closure"};
+  program * progs[3];
+  vm * v = init_vm();
+  for(int e = 0; e < 3; e++) {
+    options opts = {.simplify = 1, .repeat = 1, .eng = engines[e]};
+    progs[e] = parse_script(src, len, &opts);
+  }
+  cross_check(progs, names, 3, 1, run_parsed, v);
+  for(int e = 0; e < 3; e++)
+    free_program(progs[e]);
+  free_vm(v);
+}
+
+/**
+ * This function tests that operators on operands of known types are compiled
+ * to specialised closures or their kernels and the others to the checked
+ * operations.
+ * @param  N/a
+ * @return N/a
+ */
+void closure_kernel_test(void) {
+  const char * src = "x = 1.5\n1 + 2\nx * 2.0\nsin(2.0) + 1.0\n\"a\" + \"b\"\n"
+    "y < 2\nx + 1\n";
+  options opts = {.repeat = 1, .eng = ENGINE_CLOSURE};
+  run_stats rs = {0};
+  program * prog = init_program();
+  closure * c = NULL;
+  parse_program(prog, src, strlen(src), &opts, &rs);
+  assert(prog->statements[0].ch == NULL && prog->statements[0].cl);
+  c = prog->statements[1].cl;
+  assert(c->fn == eval_add_ii && c->is_typed && c->type == INT);
+  c = prog->statements[2].cl;
+  assert(c->fn == eval_mul_dd && c->lhs->fn == eval_load_slot
+      && c->is_typed && c->type == DOUBLE);
+  c = prog->statements[3].cl;
+  assert(c->fn == eval_add_dd && c->lhs->fn == eval_sin_d
+      && c->type == DOUBLE);
+  c = prog->statements[4].cl;
+  assert(c->fn == eval_kernel && c->bound.kernel == ast_result_add_ss
+      && c->is_typed && c->type == STRING);
+  c = prog->statements[5].cl;
+  assert(c->fn == eval_binary && c->is_typed && c->type == INT);
+  c = prog->statements[6].cl;
+  assert(c->fn == eval_kernel && c->bound.kernel == ast_result_add_di
+      && c->is_typed && c->type == DOUBLE);
+  free_program(prog);
+}
+
+int main(void) {
+  size_t len = 0;
+  char * corpus = generate_corpus(CORPUS_LINES, &len);
+  source_file * sf = load_source_file("docs/phase1.ao");
+  closure_kernel_test();
+  // An operand that assigns a variable the other operand reads
+  closure_cross_check(OPERAND_ASSIGNS, strlen(OPERAND_ASSIGNS));
+  closure_cross_check(INT_EDGES, strlen(INT_EDGES));
+  closure_cross_check(sf->src, sf->len);
+  closure_cross_check(corpus, len);
+  free_source_file(sf);
+  free(corpus);
+  free_intern_table();
+  printf("closure_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file   engine_check.c
+ * @brief  This file contains the functions the tests of the engines share: a
+ * generator of scripts that use every operator on every type it is defined
+ * for, and a cross check that runs a script with several engines and checks
+ * that every statement has the same value with all of them.
+ * @author Matthew C. Lindeman
+ * @date   October 05, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#include "engine_check.h"
+
+/** The state of the generator of the corpus (each test seeds its own) */
+unsigned int seed = 12345;
+
+/**
+ * This function returns a pseudo random number below n (a fixed sequence).
+ * @param n - The bound.
+ * @return .\ - The number.
+ */
+int next_random(int n) {
+  seed = seed * 1103515245u + 12345u;
+  return (seed >> 16) % n;
+}
+
+/**
+ * This function formats a result into a new string.
+ * @param astr - The result.
+ * @return buf - The text of the result (to be freed by the caller).
+ */
+char * format_result(ast_result astr) {
+  size_t size = ast_result_format(astr, NULL, 0) + 1;
+  char * buf = malloc(size);
+  ast_result_format(astr, buf, size);
+  return buf;
+}
+
+/**
+ * This function appends an INT expression that can not overflow (the INT
+ * variables only ever grow by a literal per line).
+ * @param   buf - The buffer to be appended to.
+ * @param depth - The number of levels of operators left.
+ * @return  N/a
+ */
+void generate_int(char * buf, int depth) {
+  const char * ops[] = {" + ", " - ", " * "};
+  switch(depth > 0 ? next_random(6) : next_random(3)) {
+    case 0:
+      sprintf(buf + strlen(buf), "%d", next_random(10));
+      return;
+    case 1:
+      sprintf(buf + strlen(buf), "i%d", next_random(8));
+      return;
+    case 2:
+      sprintf(buf + strlen(buf), "%d ^ %d", next_random(10), next_random(4));
+      return;
+    case 3:
+      strcat(buf, "(");
+      generate_int(buf, depth - 1);
+      sprintf(buf + strlen(buf), ") / %d", 1 + next_random(9));
+      return;
+    case 4:
+      strcat(buf, "sin(");
+      generate_int(buf, depth - 1);
+      strcat(buf, ")");
+      return;
+    default:
+      strcat(buf, "(");
+      generate_int(buf, depth - 1);
+      strcat(buf, ops[next_random(3)]);
+      generate_int(buf, depth - 1);
+      strcat(buf, ")");
+      return;
+  }
+}
+
+/**
+ * This function appends a DOUBLE expression.
+ * @param   buf - The buffer to be appended to.
+ * @param depth - The number of levels of operators left.
+ * @return  N/a
+ */
+void generate_double(char * buf, int depth) {
+  const char * ops[] = {" + ", " - ", " * ", " / ", " ^ "};
+  const char * functions[] = {"sin(", "cos(", "tan(", "arcsin(", "arccos(",
+    "arctan(", "log("};
+  switch(depth > 0 ? next_random(4) : next_random(2)) {
+    case 0:
+      sprintf(buf + strlen(buf), "%d.%d", next_random(10), next_random(100));
+      return;
+    case 1:
+      sprintf(buf + strlen(buf), "d%d", next_random(8));
+      return;
+    case 2:
+      strcat(buf, functions[next_random(7)]);
+      generate_double(buf, depth - 1);
+      strcat(buf, ")");
+      return;
+    default:
+      strcat(buf, "(");
+      generate_double(buf, depth - 1);
+      strcat(buf, ops[next_random(5)]);
+      generate_double(buf, depth - 1);
+      strcat(buf, ")");
+      return;
+  }
+}
+
+/**
+ * This function generates a script that uses every operator on every type it
+ * is defined for (and no mismatched types).
+ * @param qty_lines - The number of generated lines (after the assignments).
+ * @param       len - Set to the length of the script.
+ * @return      src - The script (to be freed by the caller).
+ */
+char * generate_corpus(int qty_lines, size_t * len) {
+  char * src = calloc(qty_lines + 24, 256);
+  char * line = NULL;
+  for(int i = 0; i < 8; i++)
+    sprintf(src + strlen(src), "i%d = %d\nd%d = %d.5\n", i, i, i, i);
+  for(int i = 0; i < 4; i++)
+    sprintf(src + strlen(src), "s%d = \"s%d\"\n", i, i);
+  for(int i = 0; i < qty_lines; i++) {
+    line = src + strlen(src);
+    switch(next_random(10)) {
+      case 0:
+        sprintf(line, "i%d = i%d + %d", next_random(8), next_random(8),
+            next_random(10));
+        break;
+      case 1:
+        sprintf(line, "i%d = ", next_random(8));
+        generate_int(line, 2);
+        strcat(line, next_random(2) ? " > " : " <= ");
+        generate_int(line, 2);
+        break;
+      case 2:
+        sprintf(line, "d%d = ", next_random(8));
+        generate_double(line, 3);
+        break;
+      case 3:
+        sprintf(line, "s%d = s%d + \"%c\"", next_random(4), next_random(4),
+            'a' + next_random(26));
+        break;
+      case 4:
+        sprintf(line, "s%d == s%d", next_random(4), next_random(4));
+        break;
+      case 5:
+        generate_double(line, 2);
+        strcat(line, next_random(2) ? " >= " : " < ");
+        generate_double(line, 2);
+        break;
+      case 6:
+        generate_int(line, 2);
+        strcat(line, next_random(2) ? " == " : " > ");
+        generate_int(line, 2);
+        break;
+      case 7:
+        generate_double(line, 4);
+        break;
+      case 8:
+        sprintf(line, "d%d = i%d %c d%d", next_random(8), next_random(8),
+            "+-*"[next_random(3)], next_random(8));
+        break;
+      default:
+        generate_int(line, 3);
+        break;
+    }
+    strcat(line, "\n");
+  }
+  *len = strlen(src);
+  return src;
+}
+
+/**
+ * This function parses a script into a new program.
+ * @param  src - The script.
+ * @param  len - The length of the script.
+ * @param opts - The options it is parsed with.
+ * @return prog - The program (to be freed by the caller).
+ */
+program * parse_script(const char * src, size_t len, options * opts) {
+  run_stats rs = {0};
+  program * prog = init_program();
+  parse_program(prog, src, len, opts, &rs);
+  return prog;
+}
+
+/**
+ * This function runs a statement the way its program was parsed to (the
+ * engine_runner of the programs cross_check compares as they are).
+ * @param prog - The program.
+ * @param    e - The engine (unused, it is the program's).
+ * @param    i - The index of the statement.
+ * @param   st - The variables.
+ * @param data - The vm.
+ * @return  .\ - The value of the statement.
+ */
+ast_result run_parsed(program * prog, int e, int i, symbol_table ** st,
+    void * data) {
+  (void)e;
+  return run_statement(prog, &prog->statements[i], data, st);
+}
+
+/**
+ * This function runs the statements of a script with a number of engines
+ * (each with its own variables, fresh for every run as interpret does) and
+ * checks that every statement has the same value with all of them.
+ * @param progs - The script parsed for each engine.
+ * @param names - The names of the engines (for the report of a mismatch).
+ * @param   qty - The number of engines.
+ * @param  runs - The number of times the script is run.
+ * @param   run - The function that runs a statement with an engine.
+ * @param  data - Passed on to run.
+ * @return  N/a
+ */
+void cross_check(program ** progs, const char ** names, int qty, int runs,
+    engine_runner run, void * data) {
+  symbol_table * sts[MAX_ENGINES];
+  char * texts[MAX_ENGINES];
+  ast_result result = {0};
+  for(int e = 0; e < qty; e++)
+    assert(progs[e]->qty_statements == progs[0]->qty_statements);
+  for(int r = 0; r < runs; r++) {
+    for(int e = 0; e < qty; e++) {
+      sts[e] = init_symbol_table();
+      bind_symbol_table(sts[e], progs[e]->layout);
+    }
+    for(int i = 0; i < progs[0]->qty_statements; i++) {
+      for(int e = 0; e < qty; e++) {
+        result = run(progs[e], e, i, &sts[e], data);
+        texts[e] = format_result(result);
+        // The sign of a NaN depends on the order the operands were given to
+        // the FPU in, which the engines are free to differ on
+        if(!strcmp(texts[e], "-nan"))
+          memmove(texts[e], texts[e] + 1, strlen(texts[e]));
+        free_ast_result(result);
+      }
+      for(int e = 1; e < qty; e++)
+        if(strcmp(texts[0], texts[e])) {
+          fprintf(stderr, "line %d: %s %s, %s %s\n",
+              progs[0]->statements[i].line_no, names[0], texts[0], names[e],
+              texts[e]);
+          assert(0);
+        }
+      for(int e = 0; e < qty; e++)
+        free(texts[e]);
+    }
+    for(int e = 0; e < qty; e++)
+      free_symbol_table(sts[e]);
+  }
+}
@@ -0,0 +1,43 @@
+/**
+ * @file   engine_check.h
+ * @brief  This file contains the function definitions for engine_check.c
+ * @author Matthew C. Lindeman
+ * @date   October 05, 2022
+ * @bug    None known
+ * @todo   Nothing
+ */
+#ifndef ENGINE_CHECK_H
+#define ENGINE_CHECK_H
+
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/program/include/program.h"
+
+/** A script whose INT operations overflow, divide LLONG_MIN by -1 and
+ * truncate DOUBLEs out of the range of an INT (defined the same by all) */
+#define INT_EDGES "m = 9223372036854775807\nn = 0 - m - 1\nk = 0 - 1\n" \
+  "z = 0\nm + 1\nn - 1\nm * m\nn / k\n7 / k\nlog(z)\nsin(m)\n10 ^ 30\nm ^ 2\n"
+
+/** The most engines a cross check compares */
+#define MAX_ENGINES 3
+
+/** The function that runs the i'th statement of a program with engine e
+ * (data is whatever the caller of cross_check gave) */
+typedef ast_result (*engine_runner)(program * prog, int e, int i,
+    symbol_table ** st, void * data);
+
+/** The state of the generator of the corpus */
+extern unsigned int seed;
+
+int next_random(int n);
+char * format_result(ast_result astr);
+void generate_int(char * buf, int depth);
+void generate_double(char * buf, int depth);
+char * generate_corpus(int qty_lines, size_t * len);
+program * parse_script(const char * src, size_t len, options * opts);
+ast_result run_parsed(program * prog, int e, int i, symbol_table ** st,
+    void * data);
+void cross_check(program ** progs, const char ** names, int qty, int runs,
+    engine_runner run, void * data);
+
+#endif
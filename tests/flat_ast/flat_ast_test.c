@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/lexer/include/lexer.h"
+#include "../../src/parser/include/parser.h"
+#include "../../src/parser/include/flat_ast.h"
+
+/**
+ * This function parses a line into an abstract syntax tree.
+ * @param src - The line to be parsed.
+ * @param  tb - The token buffer to lex into.
+ * @param   a - The arena the tree is allocated from.
+ * @return .\ - The tree.
+ */
+ast * parse_line(const char * src, token_buffer * tb, arena * a) {
+  lexer * lex = init_lexer(src, strlen(src));
+  ast * abstree = NULL;
+  lex_source(lex, tb);
+  abstree = parse_expression(tb, a);
+  free_lexer(lex);
+  return abstree;
+}
+
+/**
+ * This function tests that evaluating the flat form of a tree gives the same
+ * result as evaluating the tree.
+ * @param  N/a
+ * @return N/a
+ */
+void flat_ast_test(void) {
+  const char * lines[] = {
+    "x = 3.0",
+    "y = 2.5 * x ^ 2.0 - x / 2.0",
+    "sin(y) + cos(x) * tan(1.5) - log(10.0)",
+    "arcsin(0.5) + arccos(0.5) + arctan(2.0)",
+    "(x + 1.0) * (y - 1.0) >= x * y",
+    "n = (7 / 2) * 2 - 3 ^ 2",
+    "s = \"ab\" + \"cd\"",
+    "s == \"abcd\"",
+    "n < 28"
+  };
+  char tree_buf[256];
+  char flat_buf[256];
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  symbol_table * st = init_symbol_table();
+  ast * abstree = NULL;
+  flat_ast * fa = NULL;
+  ast_result tree_result = {0};
+  ast_result flat_result = {0};
+  for(size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    abstree = parse_line(lines[i], tb, a);
+    fa = flatten_tree(abstree, a);
+    assert(fa->qty_nodes == ast_count_nodes(abstree) - (abstree->value.type
+          == TOKEN_ASSIGN));
+    for(int j = 0; j < fa->qty_nodes; j++)
+      assert(fa->lhs[j] < j && fa->rhs[j] < j);
+    tree_result = evaluate_tree(abstree, &st);
+    flat_result = evaluate_flat_ast(fa, a, &st);
+    assert(tree_result.type == flat_result.type);
+    ast_result_format(tree_result, tree_buf, sizeof(tree_buf));
+    ast_result_format(flat_result, flat_buf, sizeof(flat_buf));
+    assert(!strcmp(tree_buf, flat_buf));
+    free_ast_result(tree_result);
+    free_ast_result(flat_result);
+    reset_arena(a);
+  }
+  free_symbol_table(st);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+/**
+ * This function evaluates the lines of a script with a fresh stack frame,
+ * as a tree or flattened (nothing is type checked).
+ * @param   lines - The lines.
+ * @param     qty - The number of lines.
+ * @param is_flat - Whether the lines are flattened first.
+ * @return      .\ - The value of the last line.
+ */
+ast_result evaluate_lines(const char ** lines, int qty, int is_flat) {
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  symbol_table * st = init_symbol_table();
+  ast_result result = {0};
+  ast * abstree = NULL;
+  for(int i = 0; i < qty; i++) {
+    free_ast_result(result);
+    abstree = parse_line(lines[i], tb, a);
+    result = is_flat ? evaluate_flat_ast(flatten_tree(abstree, a), a, &st)
+      : evaluate_tree(abstree, &st);
+  }
+  free_symbol_table(st);
+  free_token_buffer(tb);
+  free_arena(a);
+  return result;
+}
+
+/**
+ * This function tests that the operands of an operator are evaluated left to
+ * right when one of them assigns a variable the other reads.
+ * @param  N/a
+ * @return N/a
+ */
+void evaluation_order_test(void) {
+  const char * assigns_lhs[] = {"x = 1", "(x = 2.5) + x"};
+  const char * assigns_rhs[] = {"x = 1.5", "x + (x = 2)"};
+  for(int is_flat = 0; is_flat < 2; is_flat++) {
+    ast_result result = evaluate_lines(assigns_lhs, 2, is_flat);
+    assert(result.type == DOUBLE && result.value.double_value == 3.5);
+    result = evaluate_lines(assigns_rhs, 2, is_flat);
+    assert(result.type == DOUBLE && result.value.double_value == 2.5);
+  }
+}
+
+int main(void) {
+  flat_ast_test();
+  evaluation_order_test();
+  printf("flat_ast_test: passed\n");
+  return 0;
+}
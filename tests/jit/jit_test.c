@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/console/include/source_file.h"
+#include "../common/engine_check.h"
+
+/** The number of lines of the generated corpus */
+#define CORPUS_LINES 2000
+
+/**
+ * This function runs a script a number of times with and without native code
+ * and checks that every statement has the same value both ways.
+ * @param  src - The script.
+ * @param  len - The length of the script.
+ * @param runs - The number of times the script is run.
+ * @return N/a
+ */
+void jit_cross_check(const char * src, size_t len, int runs) {
+  const char * names[2] = {"interpreted", "native"};
+  program * progs[2];
+  vm * v = init_vm();
+  for(int e = 0; e < 2; e++) {
+    options opts = {.simplify = 1, .repeat = 1, .eng = ENGINE_VM, .jit = e};
+    progs[e] = parse_script(src, len, &opts);
+  }
+  cross_check(progs, names, 2, runs, run_parsed, v);
+  assert(progs[0]->j == NULL && progs[1]->j->qty_functions > 0);
+  for(int e = 0; e < 2; e++)
+    free_program(progs[e]);
+  free_vm(v);
+}
+
+/**
+ * This function tests which statements are compiled, that compiled code is
+ * not run once the types it was compiled for change, and that INT division
+ * by zero is left to the interpreter.
+ * @param  N/a
+ * @return N/a
+ */
+void jit_compile_test(void) {
+  const char * src = "x = 1.5\ni = 7\nz = 0\ny = x * x + sin(x) / 2.0\n"
+    "i * 3 - i ^ 2 / 2\n\"a\" + \"b\"\ni < 2\nx + u\ni / z\nx = 3\n";
+  options opts = {.repeat = 1, .eng = ENGINE_TREE, .jit = 1};
+  run_stats rs = {0};
+  program * prog = init_program();
+  symbol_table * st = init_symbol_table();
+  statement * stmts = NULL;
+  jit_function * jf = NULL;
+  ast_result result = {0};
+  int expect_native[] = {1, 1, 1, 1, 1, 0, 0};
+  parse_program(prog, src, strlen(src), &opts, &rs);
+  bind_symbol_table(st, prog->layout);
+  stmts = prog->statements;
+  for(int i = 0; i < 7; i++) {
+    result = run_statement(prog, &stmts[i], NULL, &st);
+    assert((stmts[i].jf != NULL) == expect_native[i]);
+    if(i == 3)
+      assert(result.type == INT && st->udv[stmts[i].abstree->slot]->type
+          == DOUBLE && st->udv[stmts[i].abstree->slot]->value.double_value
+          == 1.5 * 1.5 + sin(1.5) / 2.0);
+    if(i == 4)
+      assert(result.type == INT && result.value.int_value == 7 * 3 - 49 / 2);
+    free_ast_result(result);
+  }
+  // A variable that is not set is left to the interpreter
+  assert(jit_compile(prog->j, stmts[7].abstree, st, prog->a) == NULL);
+  // INT division by zero bails out of the native code
+  jf = jit_compile(prog->j, stmts[8].abstree, st, prog->a);
+  assert(jf && !jit_run(jf, &st, &result));
+  // Once x is an INT the code compiled for a DOUBLE x is not run
+  result = run_statement(prog, &stmts[9], NULL, &st);
+  assert(!jit_run(stmts[3].jf, &st, &result));
+  free_symbol_table(st);
+  free_program(prog);
+}
+
+int main(void) {
+  size_t len = 0;
+  char * corpus = NULL;
+  source_file * sf = load_source_file("docs/phase1.ao");
+  seed = 4242;
+  corpus = generate_corpus(CORPUS_LINES, &len);
+#if defined(__x86_64__)
+  jit_compile_test();
+#endif
+  jit_cross_check(INT_EDGES, strlen(INT_EDGES), 3);
+  jit_cross_check(sf->src, sf->len, 3);
+  jit_cross_check(corpus, len, 3);
+  free_source_file(sf);
+  free(corpus);
+  free_intern_table();
+  printf("jit_test: passed\n");
+  return 0;
+}
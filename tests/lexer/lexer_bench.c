@@ -0,0 +1,75 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+#include "../../src/lexer/include/lexer.h"
+
+/**
+ * This function returns the current monotonic time in seconds.
+ * @param N/a
+ * @return .\ - The time in seconds.
+ */
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * This function generates a source of qty_lines lines that uses every kind of
+ * token.  A wide source is deeply indented and has long names, numbers and
+ * strings (like generated code).
+ * @param qty_lines - The number of lines.
+ * @param      wide - Whether the source is wide.
+ * @param       len - Set to the length of the source.
+ * @return      src - The source (to be freed by the caller).
+ */
+char * generate_source(int qty_lines, int wide, size_t * len) {
+  size_t cap = 512 * (size_t)qty_lines;
+  char * src = malloc(cap);
+  *len = 0;
+  for(int i = 0; i < qty_lines; i++)
+    *len += wide ? snprintf(src + *len, cap - *len, "%64svery_long_generated_"
+        "variable_name_%d = 1234567890123456.25 + \"%0200d\" == s\n", "",
+        i % 97, i)
+      : snprintf(src + *len, cap - *len, "  value_%d = (x_%d * 3.25 + "
+        "arcsin(y) ^ 2) / [%d, %d] >= 10 || s == \"str %d\" <= z\n", i % 97,
+        i % 13, i, i + 1, i);
+  return src;
+}
+
+/**
+ * This function times lexing a generated source rounds times.
+ * @param qty_lines - The number of lines in the source.
+ * @param      wide - Whether the source is wide (see generate_source).
+ * @param    rounds - The number of times the source is lexed.
+ * @return N/a
+ */
+void lexer_bench(int qty_lines, int wide, int rounds) {
+  size_t len = 0;
+  char * src = generate_source(qty_lines, wide, &len);
+  token_buffer * tb = init_token_buffer();
+  lexer * l = NULL;
+  long long qty_tokens = 0;
+  double start = now();
+  for(int i = 0; i < rounds; i++) {
+    l = init_lexer(src, len);
+    while(!lex_at_end(l)) {
+      lex_source(l, tb);
+      qty_tokens += tb->qty_tokens;
+    }
+    free_lexer(l);
+  }
+  double elapsed = now() - start;
+  printf("%s %8d lines: %lld tokens in %.3f s, %.1f M tokens/s, %.1f MB/s\n",
+      wide ? "wide  " : "narrow", qty_lines, qty_tokens, elapsed,
+      qty_tokens / elapsed / 1e6, len * (double)rounds / elapsed / 1e6);
+  free_token_buffer(tb);
+  free(src);
+}
+
+int main(void) {
+  lexer_bench(100000, 0, 20);
+  lexer_bench(100000, 1, 20);
+  free_intern_table();
+  return 0;
+}
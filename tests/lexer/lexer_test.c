@@ -0,0 +1,159 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../../src/lexer/include/lexer.h"
+
+/**
+ * This function tests that keywords, and only keywords, are recognized.
+ * @param  N/a
+ * @return N/a
+ */
+void classify_word_test(void) {
+  const char * keywords[] = {"sin", "cos", "tan", "arcsin", "arccos",
+    "arctan", "log"};
+  token_type types[] = {TOKEN_SIN, TOKEN_COS, TOKEN_TAN, TOKEN_ARC_SIN,
+    TOKEN_ARC_COS, TOKEN_ARC_TAN, TOKEN_LOG};
+  const char * words[] = {"s", "si", "sim", "sinx", "arcsim", "arcsinh",
+    "arctin", "axcsin", "lag", "x", "tab", "arc"};
+  for(size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+    assert(classify_word(keywords[i], strlen(keywords[i])) == types[i]);
+  for(size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++)
+    assert(classify_word(words[i], strlen(words[i])) == TOKEN_VAR);
+  // The word is a slice of the source
+  assert(classify_word("sine", 3) == TOKEN_SIN);
+}
+
+/**
+ * This function tests lexing a line of words.
+ * @param  N/a
+ * @return N/a
+ */
+void lex_word_test(void) {
+  const char * src = "arcsin(sinh) + log_2\n";
+  token_type types[] = {TOKEN_ARC_SIN, TOKEN_L_PAREN, TOKEN_VAR, TOKEN_R_PAREN,
+    TOKEN_PLUS, TOKEN_VAR, TOKEN_NEWLINE};
+  lexer * l = init_lexer(src, strlen(src));
+  token_buffer * tb = init_token_buffer();
+  lex_source(l, tb);
+  assert(tb->qty_tokens == sizeof(types) / sizeof(types[0]));
+  for(size_t i = 0; i < tb->qty_tokens; i++)
+    assert(tb->tokens[i].type == types[i]);
+  assert(tb->tokens[2].value.atom_value == intern("sinh", 4));
+  assert(token_equals(tb->tokens[5], "log_2"));
+  free_token_buffer(tb);
+  free_lexer(l);
+}
+
+/**
+ * This function tests the scans against a byte at a time reference, on runs
+ * of every length from every offset.  The source is allocated to its exact
+ * length so a scan reading past it is caught by the address sanitizer.
+ * @param  N/a
+ * @return N/a
+ */
+void scan_test(void) {
+  const char * fill[] = {" \t", "aZ_9", "0.", "x \"=+"};
+  const char * stops = "\"\n\r;";
+  size_t expected = 0;
+  for(size_t len = 1; len <= 80; len++) {
+    char * src = malloc(len);
+    for(size_t k = 0; k < 4; k++) {
+      for(size_t run = 0; run <= len; run++) {
+        for(size_t i = 0; i < len; i++)
+          src[i] = i < run ? fill[k][i % strlen(fill[k])] : stops[i % 4];
+        for(size_t start = 0; start <= len; start += 7) {
+          expected = start > run ? start : run;
+          switch(k) {
+            case 0:
+              assert(scan_whitespace(src, start, len) == expected);
+              break;
+            case 1:
+              assert(scan_word(src, start, len) == expected);
+              break;
+            case 2:
+              assert(scan_number(src, start, len) == expected);
+              break;
+            case 3:
+              // A string body runs up to the first quote
+              expected = start;
+              while(expected < len && src[expected] != '"'
+                  && src[expected] != '\n' && src[expected] != '\r')
+                expected++;
+              assert(scan_string(src, start, len) == expected);
+              break;
+          }
+        }
+      }
+    }
+    free(src);
+  }
+  // Bytes of 0x80 and over end a word
+  assert(scan_word("abcdefghijklmnopqrstuvw\xe9xyz", 0, 27) == 23);
+}
+
+/**
+ * This function lexes every line of a source in a child process and tells
+ * whether the lexer stopped the program (a child that hangs is killed).
+ * @param src - The source.
+ * @param len - The length of the source.
+ * @return .\ - 1 if the child exited with status 1, 0 otherwise.
+ */
+int lex_exits(const char * src, size_t len) {
+  int status = 0;
+  pid_t pid = fork();
+  if(pid == 0) {
+    lexer * lex = init_lexer(src, len);
+    token_buffer * tb = init_token_buffer();
+    alarm(5);
+    freopen("/dev/null", "w", stderr);
+    while(!lex_at_end(lex))
+      lex_source(lex, tb);
+    _exit(0);
+  }
+  waitpid(pid, &status, 0);
+  return WIFEXITED(status) && WEXITSTATUS(status) == 1;
+}
+
+/**
+ * This function tests that a NUL byte inside the source is an unrecognized
+ * character rather than the end of a line.
+ * @param  N/a
+ * @return N/a
+ */
+void nul_byte_test(void) {
+  assert(lex_exits("x = 1\n\0\nx\n", 10));
+  assert(lex_exits("x = 1 \0 + 2", 12));
+  assert(!lex_exits("x = 1\n", 6));
+}
+
+/**
+ * This function tests that INT literals too big for an INT saturate at
+ * LLONG_MAX instead of overflowing.
+ * @param  N/a
+ * @return N/a
+ */
+void int_literal_test(void) {
+  const char * src = "9223372036854775807 9223372036854775808 "
+    "99999999999999999999\n";
+  lexer * l = init_lexer(src, strlen(src));
+  token_buffer * tb = init_token_buffer();
+  lex_source(l, tb);
+  for(size_t i = 0; i < 3; i++)
+    assert(tb->tokens[i].type == TOKEN_INT
+        && tb->tokens[i].value.int_value == LLONG_MAX);
+  free_token_buffer(tb);
+  free_lexer(l);
+}
+
+int main(void) {
+  classify_word_test();
+  lex_word_test();
+  scan_test();
+  nul_byte_test();
+  int_literal_test();
+  free_intern_table();
+  printf("lexer_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/lexer/include/lexer.h"
+#include "../../src/parser/include/parser.h"
+
+/**
+ * This function parses a line.
+ * @param src - The line to be parsed.
+ * @param  tb - The token buffer to lex into.
+ * @param   a - The arena the tree is allocated from.
+ * @return .\ - The tree.
+ */
+ast * parse_line(const char * src, token_buffer * tb, arena * a) {
+  lexer * lex = init_lexer(src, strlen(src));
+  ast * abstree = NULL;
+  lex_source(lex, tb);
+  abstree = parse_expression(tb, a);
+  free_lexer(lex);
+  return abstree;
+}
+
+/**
+ * This function tests the precedence and associativity of the operators.
+ * @param  N/a
+ * @return N/a
+ */
+void parser_precedence_test(void) {
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  ast * abstree = parse_line("a - b - c", tb, a);
+  assert(abstree->value.type == TOKEN_MINUS
+      && abstree->children[0]->value.type == TOKEN_MINUS
+      && token_equals(abstree->children[1]->value, "c"));
+  abstree = parse_line("a ^ b ^ c", tb, a);
+  assert(abstree->value.type == TOKEN_POWER
+      && token_equals(abstree->children[0]->value, "a")
+      && abstree->children[1]->value.type == TOKEN_POWER);
+  abstree = parse_line("x = a + b * c == d", tb, a);
+  assert(abstree->value.type == TOKEN_ASSIGN
+      && abstree->children[1]->value.type == TOKEN_EQUALITY
+      && abstree->children[1]->children[0]->value.type == TOKEN_PLUS
+      && abstree->children[1]->children[0]->children[1]->value.type
+      == TOKEN_MULT);
+  abstree = parse_line("sin x ^ 2 * 3", tb, a);
+  assert(abstree->value.type == TOKEN_MULT
+      && abstree->children[0]->value.type == TOKEN_SIN
+      && abstree->children[0]->children[0]->value.type == TOKEN_POWER);
+  abstree = parse_line("(a + b) * c", tb, a);
+  assert(abstree->value.type == TOKEN_MULT
+      && abstree->children[0]->value.type == TOKEN_PLUS);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+/**
+ * This function tests that a long chain of operators parses into a left
+ * leaning tree.
+ * @param  N/a
+ * @return N/a
+ */
+void parser_chain_test(void) {
+  int qty_terms = 10000;
+  char * src = calloc(qty_terms * 4 + 2, sizeof(char));
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  ast * abstree = NULL;
+  int depth = 0;
+  src[0] = '1';
+  for(int i = 1; i < qty_terms; i++)
+    memcpy(src + (i - 1) * 4 + 1, " + 1", 4);
+  src[(qty_terms - 1) * 4 + 1] = '\n';
+  abstree = parse_line(src, tb, a);
+  assert(ast_count_nodes(abstree) == 2 * qty_terms - 1);
+  for(ast * node = abstree; node->no_children; node = node->children[0]) {
+    assert(node->children[1]->no_children == 0);
+    depth++;
+  }
+  assert(depth == qty_terms - 1);
+  free(src);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+int main(void) {
+  parser_precedence_test();
+  parser_chain_test();
+  printf("parser_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,127 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../../src/lexer/include/lexer.h"
+#include "../../src/program/include/program.h"
+
+/**
+ * This function parses, resolves, type checks and simplifies a line (a line
+ * that is not well typed is still simplified).
+ * @param    src - The line to be simplified.
+ * @param     tb - The token buffer to lex into.
+ * @param      a - The arena the tree is allocated from.
+ * @param layout - The frame layout the variables are resolved to.
+ * @param    env - The types of the variables before the line.
+ * @return    .\ - The simplified tree.
+ */
+ast * simplify_line(const char * src, token_buffer * tb, arena * a,
+    symbol_table * layout, type_env * env) {
+  lexer * lex = init_lexer(src, strlen(src));
+  type_error err = {0};
+  ast * abstree = NULL;
+  lex_source(lex, tb);
+  abstree = parse_expression(tb, a);
+  free_lexer(lex);
+  resolve_tree(abstree, layout);
+  type_check_tree(abstree, env, &err);
+  return simplify_tree(a, abstree);
+}
+
+/**
+ * This function tests constant folding and the algebraic identities of
+ * simplify_tree.
+ * @param  N/a
+ * @return N/a
+ */
+void simplify_tree_test(void) {
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  symbol_table * layout = init_symbol_table();
+  type_env * env = init_type_env();
+  ast * abstree = simplify_line("2 * 3 + 4", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_INT && abstree->value.value.int_value
+      == 10 && abstree->no_children == 0);
+  abstree = simplify_line("log(1.0) + cos(0.0)", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_DOUBLE
+      && abstree->value.value.double_value == 1.0);
+  abstree = simplify_line("1 + 0.5 * 3", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_DOUBLE
+      && abstree->value.value.double_value == 2.5);
+  abstree = simplify_line("1 + \"a\"", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_PLUS);
+  abstree = simplify_line("1.5 / 0", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_DOUBLE);
+  abstree = simplify_line("\"ab\" + \"cd\"", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_STRING && token_equals(abstree->value,
+        "abcd"));
+  // The identities need x to be known to be a number
+  abstree = simplify_line("x * 1 + 0", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_PLUS && ast_count_nodes(abstree) == 5);
+  abstree = simplify_line("x = 2.5", tb, a, layout, env);
+  abstree = simplify_line("x * 1 + 0", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_VAR && ast_count_nodes(abstree) == 1);
+  abstree = simplify_line("x ^ (3 - 2)", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_VAR);
+  abstree = simplify_line("x ^ 2", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_MULT
+      && abstree->children[0]->value.type == TOKEN_VAR
+      && abstree->children[1]->value.type == TOKEN_VAR
+      && abstree->type == DOUBLE && abstree->kernel == ast_result_mul_dd);
+  abstree = simplify_line("x * 1.0", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_MULT);
+  abstree = simplify_line("y = 1 + x * (2 * 3)", tb, a, layout, env);
+  assert(ast_count_nodes(abstree) == 7);
+  abstree = simplify_line("s = \"ab\"", tb, a, layout, env);
+  abstree = simplify_line("s * 1", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_MULT);
+  abstree = simplify_line("0 + s", tb, a, layout, env);
+  assert(abstree->value.type == TOKEN_PLUS);
+  free_type_env(env);
+  free_symbol_table(layout);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+/**
+ * This function runs a script (simplified) in a child process and tells
+ * whether it stopped the program.
+ * @param src - The script.
+ * @return .\ - 1 if the child exited with status 1, 0 otherwise.
+ */
+int script_exits(const char * src) {
+  int status = 0;
+  pid_t pid = fork();
+  if(pid == 0) {
+    options opts = {.simplify = 1, .repeat = 1, .eng = ENGINE_TREE};
+    run_stats rs = {0};
+    program * prog = init_program();
+    freopen("/dev/null", "w", stderr);
+    parse_program(prog, src, strlen(src), &opts, &rs);
+    _exit(0);
+  }
+  waitpid(pid, &status, 0);
+  return WIFEXITED(status) && WEXITSTATUS(status) == 1;
+}
+
+/**
+ * This function tests that the identities do not remove the type error of an
+ * operator on a STRING.
+ * @param  N/a
+ * @return N/a
+ */
+void simplify_type_error_test(void) {
+  assert(script_exits("s = \"ab\"\ns * 1\n"));
+  assert(script_exits("s = \"ab\"\ns + 0\n"));
+  assert(script_exits("s = \"ab\"\ns ^ 1\n"));
+  assert(script_exits("s = \"ab\"\n1 * s\n"));
+  assert(!script_exits("x = 2\nx * 1\n"));
+}
+
+int main(void) {
+  simplify_tree_test();
+  simplify_type_error_test();
+  printf("simplify_tree_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/lexer/include/lexer.h"
+#include "../../src/parser/include/parser.h"
+#include "../../src/parser/include/type_check.h"
+
+/**
+ * This function parses, resolves and type checks a line.
+ * @param    src - The line to be checked.
+ * @param     tb - The token buffer to lex into.
+ * @param      a - The arena the tree is allocated from.
+ * @param layout - The frame layout the variables are resolved to.
+ * @param    env - The types of the variables before the line.
+ * @param    err - Set to the error found (if any).
+ * @return    .\ - The tree, NULL if it is not well typed.
+ */
+ast * check_line(const char * src, token_buffer * tb, arena * a,
+    symbol_table * layout, type_env * env, type_error * err) {
+  lexer * lex = init_lexer(src, strlen(src));
+  ast * abstree = NULL;
+  lex_source(lex, tb);
+  abstree = parse_expression(tb, a);
+  free_lexer(lex);
+  resolve_tree(abstree, layout);
+  return type_check_tree(abstree, env, err) ? abstree : NULL;
+}
+
+/**
+ * This function tests that the types of variables follow the assignments
+ * and that operators on known types get their kernels (promoting mixed INT
+ * and DOUBLE operands).
+ * @param  N/a
+ * @return N/a
+ */
+void type_check_annotation_test(void) {
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  symbol_table * layout = init_symbol_table();
+  type_env * env = init_type_env();
+  type_error err = {0};
+  ast * abstree = check_line("x = 1.5", tb, a, layout, env, &err);
+  assert(abstree && abstree->is_typed && abstree->type == INT);
+  abstree = check_line("x * 2.0", tb, a, layout, env, &err);
+  assert(abstree->type == DOUBLE && abstree->kernel == ast_result_mul_dd
+      && abstree->children[0]->is_typed);
+  abstree = check_line("x = 3", tb, a, layout, env, &err);
+  abstree = check_line("sin(x) / 2 < x", tb, a, layout, env, &err);
+  assert(abstree->type == INT && abstree->kernel == ast_result_lt_ii
+      && abstree->children[0]->kernel == ast_result_div_ii);
+  abstree = check_line("s = \"a\" + \"b\"", tb, a, layout, env, &err);
+  abstree = check_line("s == \"ab\"", tb, a, layout, env, &err);
+  assert(abstree->is_typed && abstree->type == INT
+      && abstree->kernel == ast_result_eq_ss);
+  // An INT meeting a DOUBLE is promoted
+  abstree = check_line("x + 2.5 * x", tb, a, layout, env, &err);
+  assert(abstree->type == DOUBLE && abstree->kernel == ast_result_add_id
+      && abstree->children[1]->kernel == ast_result_mul_di);
+  abstree = check_line("0.5 <= x", tb, a, layout, env, &err);
+  assert(abstree->type == INT && abstree->kernel == ast_result_lteq_di);
+  // A variable that is not set has no type, and neither has what uses it
+  abstree = check_line("u + x", tb, a, layout, env, &err);
+  assert(abstree && !abstree->is_typed && !abstree->kernel);
+  abstree = check_line("u < x", tb, a, layout, env, &err);
+  assert(abstree->is_typed && abstree->type == INT && !abstree->kernel);
+  abstree = check_line("x = u", tb, a, layout, env, &err);
+  abstree = check_line("x + 1.5", tb, a, layout, env, &err);
+  assert(abstree && !abstree->is_typed);
+  free_type_env(env);
+  free_symbol_table(layout);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+/**
+ * This function tests that type errors are found before anything runs.
+ * @param  N/a
+ * @return N/a
+ */
+void type_check_error_test(void) {
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  symbol_table * layout = init_symbol_table();
+  type_env * env = init_type_env();
+  type_error err = {0};
+  assert(check_line("x = 1", tb, a, layout, env, &err));
+  assert(check_line("x + 2.5", tb, a, layout, env, &err));
+  assert(!check_line("x + \"s\"", tb, a, layout, env, &err));
+  assert(!err.is_unsupported && err.lhs == INT && err.rhs == STRING
+      && token_equals(err.op, "+"));
+  assert(check_line("x = \"s\"", tb, a, layout, env, &err));
+  assert(!check_line("x * 2", tb, a, layout, env, &err));
+  assert(!check_line("log(x)", tb, a, layout, env, &err));
+  assert(err.is_unsupported && err.lhs == STRING
+      && token_equals(err.op, "log"));
+  assert(!check_line("x < \"t\"", tb, a, layout, env, &err));
+  assert(err.is_unsupported && token_equals(err.op, "<"));
+  // Operators without kernels are unsupported (and are not looked up)
+  assert(!check_line("1 || 2", tb, a, layout, env, &err));
+  assert(err.is_unsupported && token_equals(err.op, "||"));
+  assert(!check_line("[1, 2]", tb, a, layout, env, &err));
+  assert(err.is_unsupported && token_equals(err.op, "[]"));
+  assert(!check_line("[1]", tb, a, layout, env, &err));
+  assert(err.is_unsupported && token_equals(err.op, "[]"));
+  free_type_env(env);
+  free_symbol_table(layout);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+/**
+ * This function tests the kernel tables: INT operands are promoted when they
+ * meet DOUBLE ones and there is no kernel for the types an operator is not
+ * defined on.
+ * @param  N/a
+ * @return N/a
+ */
+void kernel_table_test(void) {
+  ast_result r = ast_result_binary(BINARY_DIV, int_ast_result(3),
+      double_ast_result(2.0));
+  assert(r.type == DOUBLE && r.value.double_value == 1.5);
+  r = ast_result_binary(BINARY_POW, double_ast_result(0.5), int_ast_result(2));
+  assert(r.type == DOUBLE && r.value.double_value == 0.25);
+  r = ast_result_binary(BINARY_LT, double_ast_result(0.5), int_ast_result(1));
+  assert(r.type == INT && r.value.int_value == 1);
+  r = ast_result_binary(BINARY_DIV, int_ast_result(7), int_ast_result(2));
+  assert(r.type == INT && r.value.int_value == 3);
+  r = ast_result_unary(UNARY_COS, int_ast_result(0));
+  assert(r.type == INT && r.value.int_value == 1);
+  assert(binary_result_type(BINARY_SUB, INT, DOUBLE) == DOUBLE);
+  assert(binary_result_type(BINARY_EQ, DOUBLE, DOUBLE) == INT);
+  assert(!BINARY_KERNELS[BINARY_ADD][STRING][INT]);
+  assert(!BINARY_KERNELS[BINARY_ADD][DOUBLE][STRING]);
+  assert(!BINARY_KERNELS[BINARY_SUB][STRING][STRING]);
+  assert(!UNARY_KERNELS[UNARY_LOG][STRING]);
+}
+
+int main(void) {
+  kernel_table_test();
+  type_check_annotation_test();
+  type_check_error_test();
+  free_intern_table();
+  printf("type_check_test: passed\n");
+  return 0;
+}
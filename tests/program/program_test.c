@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/program/include/program.h"
+
+/**
+ * This function tests that a program keeps every statement of a script with
+ * its line number and stops at the line "exit".
+ * @param  N/a
+ * @return N/a
+ */
+void program_test(void) {
+  const char * src = "x = 2\n\ny = x * 3\r\nx + y\nexit\nz\n";
+  options opts = {.simplify = 1, .repeat = 1, .eng = ENGINE_VM};
+  run_stats rs = {0};
+  program * prog = init_program();
+  symbol_table * st = init_symbol_table();
+  vm * v = init_vm();
+  int y = 0;
+  parse_program(prog, src, strlen(src), &opts, &rs);
+  assert(prog->qty_statements == 3 && rs.qty_lines == 3);
+  assert(prog->statements[0].line_no == 1);
+  assert(prog->statements[1].line_no == 3);
+  assert(prog->statements[2].line_no == 4);
+  for(int i = 0; i < 2; i++) {
+    run_program(prog, v, &st, &rs);
+    y = find_variable(st, "y");
+    assert(y != -1 && st->udv[y]->value.int_value == 6);
+  }
+  reset_program(prog);
+  assert(prog->qty_statements == 0);
+  free_symbol_table(st);
+  free_program(prog);
+  free_vm(v);
+}
+
+int main(void) {
+  program_test();
+  printf("program_test: passed\n");
+  return 0;
+}
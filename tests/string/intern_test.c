@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/string/include/intern.h"
+
+/**
+ * This function tests that a name has exactly one atom.
+ * @param  N/a
+ * @return N/a
+ */
+void intern_test(void) {
+  const atom * x = intern("x = 1", 1);
+  const atom * xy = intern("xy", 2);
+  assert(x != xy && x->len == 1 && !strcmp(x->name, "x"));
+  assert(intern("x", 1) == x && intern("xyz", 2) == xy);
+  assert(x->id == 0 && xy->id == 1 && x->hash == hash_name("x", 1));
+  assert(find_atom("xy", 2) == xy && find_atom("y", 1) == NULL);
+  assert(INTERN_TABLE->qty_atoms == 2);
+}
+
+/**
+ * This function tests that the atoms survive the intern table growing.
+ * @param  N/a
+ * @return N/a
+ */
+void intern_grow_test(void) {
+  char name[64];
+  const atom * atoms[10000];
+  for(int i = 0; i < 10000; i++) {
+    snprintf(name, sizeof(name), "v%d", i);
+    atoms[i] = intern(name, strlen(name));
+  }
+  for(int i = 0; i < 10000; i++) {
+    snprintf(name, sizeof(name), "v%d", i);
+    assert(find_atom(name, strlen(name)) == atoms[i]);
+    assert(INTERN_TABLE->atoms[atoms[i]->id] == atoms[i]);
+  }
+  assert(2 * INTERN_TABLE->qty_atoms <= INTERN_TABLE->qty_buckets);
+}
+
+int main(void) {
+  intern_test();
+  intern_grow_test();
+  free_intern_table();
+  assert(find_atom("x", 1) == NULL);
+  printf("intern_test: passed\n");
+  return 0;
+}
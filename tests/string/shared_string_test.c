@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../../src/string/include/shared_string.h"
+
+/**
+ * This function tests reference counting and copy on write.
+ * @param  N/a
+ * @return N/a
+ */
+void shared_string_test(void) {
+  shared_string * a = init_shared_string("foo!", 3);
+  shared_string * b = retain_shared_string(a);
+  shared_string * c = NULL;
+  assert(a == b && a->refs == 2 && a->len == 3 && !strcmp(a->data, "foo"));
+  // a is shared so concatenating to it copies
+  c = shared_string_concat(b, init_shared_string("bar", 3));
+  assert(c != a && a->refs == 1 && !strcmp(a->data, "foo"));
+  assert(c->refs == 1 && c->len == 6 && !strcmp(c->data, "foobar"));
+  // c has a single owner so it is appended to in place
+  c = shared_string_concat(c, retain_shared_string(a));
+  assert(!strcmp(c->data, "foobarfoo") && a->refs == 1);
+  assert(!shared_string_equals(a, c));
+  b = init_shared_string("foobarfoo", 9);
+  assert(shared_string_equals(b, c));
+  release_shared_string(a);
+  release_shared_string(b);
+  release_shared_string(c);
+}
+
+/**
+ * This function tests that arena strings are never freed and are copied by
+ * anything that keeps them.
+ * @param  N/a
+ * @return N/a
+ */
+void shared_string_arena_test(void) {
+  arena * ar = init_arena();
+  shared_string * lit = arena_shared_string(ar, "literal", 7);
+  shared_string * kept = keep_shared_string(lit);
+  assert(lit->refs == 0 && retain_shared_string(lit)->refs == 0);
+  assert(kept != lit && kept->refs == 1 && shared_string_equals(kept, lit));
+  release_shared_string(lit);
+  release_shared_string(kept);
+  free_arena(ar);
+}
+
+/**
+ * This function tests that building a string up onto a shared string makes a
+ * rope that reads back correctly, however deep it is.
+ * @param  N/a
+ * @return N/a
+ */
+void shared_string_rope_test(void) {
+  int qty_pieces = 100000;
+  shared_string * acc = init_shared_string("", 0);
+  shared_string * held = NULL;
+  const char * data = NULL;
+  for(int i = 0; i < qty_pieces; i++) {
+    // Like a variable: the accumulator is shared while it is concatenated
+    held = retain_shared_string(acc);
+    acc = shared_string_concat(acc, init_shared_string(i % 2 ? "b" : "a", 1));
+    release_shared_string(held);
+  }
+  assert(acc->len == (size_t)qty_pieces && acc->data == NULL);
+  data = shared_string_data(acc);
+  assert(acc->left == NULL && strlen(data) == (size_t)qty_pieces);
+  for(int i = 0; i < qty_pieces; i++)
+    assert(data[i] == (i % 2 ? 'b' : 'a'));
+  release_shared_string(acc);
+  acc = init_shared_string("", 0);
+  for(int i = 0; i < qty_pieces; i++) {
+    held = retain_shared_string(acc);
+    acc = shared_string_concat(acc, init_shared_string("c", 1));
+    release_shared_string(held);
+  }
+  // Freeing an unread rope must not recurse
+  release_shared_string(acc);
+}
+
+/**
+ * This function tests that appending to a string with a single owner reuses
+ * its buffer.
+ * @param  N/a
+ * @return N/a
+ */
+void shared_string_builder_test(void) {
+  shared_string * acc = init_shared_string("x", 1);
+  size_t qty_grows = 0;
+  size_t cap = acc->cap;
+  for(int i = 0; i < 10000; i++) {
+    acc = shared_string_concat(acc, init_shared_string("y", 1));
+    if(acc->cap != cap)
+      qty_grows++;
+    cap = acc->cap;
+  }
+  assert(acc->len == 10001 && qty_grows < 20);
+  release_shared_string(acc);
+}
+
+int main(void) {
+  shared_string_test();
+  shared_string_arena_test();
+  shared_string_rope_test();
+  shared_string_builder_test();
+  printf("shared_string_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,50 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+#include "../../src/symbol_table/include/symbol_table.h"
+#include "../../src/symbol_table/include/variable.h"
+
+/**
+ * This function returns the current monotonic time in seconds.
+ * @param N/a
+ * @return .\ - The time in seconds.
+ */
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * This function times adding qty variables to a symbol_table and then looking
+ * each of them up.
+ * @param qty - The number of variables.
+ * @return N/a
+ */
+void symbol_table_bench(int qty) {
+  char name[64];
+  long long value = 0;
+  long long found = 0;
+  symbol_table * st = init_symbol_table();
+  double start = now();
+  for(value = 0; value < qty; value++) {
+    snprintf(name, sizeof(name), "variable_%lld", value);
+    add_variable(st, init_variable(name, &value, INT));
+  }
+  double inserted = now();
+  for(value = 0; value < qty; value++) {
+    snprintf(name, sizeof(name), "variable_%lld", value);
+    found += find_variable(st, name) == value;
+  }
+  double looked_up = now();
+  printf("%8d variables: insert %8.1f ns/op, find %8.1f ns/op (%lld found)\n",
+      qty, (inserted - start) * 1e9 / qty, (looked_up - inserted) * 1e9 / qty,
+      found);
+  free_symbol_table(st);
+}
+
+int main(void) {
+  for(int qty = 10; qty <= 1000000; qty *= 10)
+    symbol_table_bench(qty);
+  return 0;
+}
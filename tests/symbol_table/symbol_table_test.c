@@ -1,26 +1,110 @@
 #include <stdio.h>
-#include "../lexer/include/lexer.h"
-#include "../token/include/token_stack.h"
-#include "../parser/include/parser.h"
-#include "../symbol_table/include/symbol_table.h"
-#include "../symbol_table/include/variable.h"
-#include "../symbol_table/include/var_type.h"
+#include <assert.h>
+#include "../../src/symbol_table/include/symbol_table.h"
+#include "../../src/symbol_table/include/variable.h"
+#include "../../src/symbol_table/include/var_type.h"
 
 /**
  * This function tests the cases in which a symbol_table can be initialized.
  * @param  N/a
  * @return N/a
  */
-symbol_table_test(void) {
+void symbol_table_test(void) {
+  double x = 1.2;
+  long long z = 1;
+  shared_string * y = init_shared_string("some string", 11);
   symbol_table * st = init_symbol_table();
-  add_variable(st, init_variable("x", "1.2", DOUBLE));
-  add_variable(st, init_variable("y", "some string", STRING));
-  add_variable(st, init_variable("z", "1", INT));
+  add_variable(st, init_variable("x", &x, DOUBLE));
+  add_variable(st, init_variable("y", y, STRING));
+  release_shared_string(y);
+  add_variable(st, init_variable("z", &z, INT));
   int i = find_variable(st, "x");
   int j = find_variable(st, "y");
   int k = find_variable(st, "z");
+  assert(i == 0 && j == 1 && k == 2);
+  assert(find_variable(st, "w") == -1);
   variable_dump_debug(st->udv[i]);
   variable_dump_debug(st->udv[j]);
   variable_dump_debug(st->udv[k]);
   free_symbol_table(st);
 }
+
+/**
+ * This function tests that a symbol_table keeps finding every variable while
+ * its index grows.
+ * @param  N/a
+ * @return N/a
+ */
+void symbol_table_growth_test(void) {
+  char name[64];
+  long long value = 0;
+  symbol_table * st = init_symbol_table();
+  for(value = 0; value < 10000; value++) {
+    snprintf(name, sizeof(name), "v%lld", value);
+    add_variable(st, init_variable(name, &value, INT));
+  }
+  for(value = 0; value < 10000; value++) {
+    snprintf(name, sizeof(name), "v%lld", value);
+    assert(find_variable(st, name) == value);
+  }
+  value = 7;
+  assert(assign_variable(st, "v42", 3, &value, INT) == 42);
+  assert(st->udv[42]->value.int_value == 7);
+  assert(assign_variable(st, "new", 3, &value, INT) == 10000);
+  free_symbol_table(st);
+}
+
+/**
+ * This function tests that declared slots are stable and that a symbol_table
+ * bound to a layout reproduces its slots.
+ * @param  N/a
+ * @return N/a
+ */
+void symbol_table_slot_test(void) {
+  long long value = 3;
+  symbol_table * layout = init_symbol_table();
+  symbol_table * st = init_symbol_table();
+  assert(declare_variable(layout, "a", 1) == 0);
+  assert(declare_variable(layout, "bc", 2) == 1);
+  assert(declare_variable(layout, "a", 1) == 0);
+  assert(!layout->udv[1]->is_set);
+  bind_symbol_table(st, layout);
+  assert(st->qty_udv == 2 && find_variable(st, "bc") == 1);
+  assign_variable_at(st, 1, &value, INT);
+  assert(st->udv[1]->value.int_value == 3 && !strcmp(st->udv[1]->name->name,
+        "bc"));
+  assert(assign_variable(st, "bc", 2, &value, INT) == 1);
+  free_symbol_table(st);
+  free_symbol_table(layout);
+}
+
+/**
+ * This function tests that reassigning a variable updates it in place and
+ * that strings are shared with the variable rather than copied.
+ * @param  N/a
+ * @return N/a
+ */
+void variable_in_place_test(void) {
+  double d = 2.5;
+  shared_string * str = init_shared_string("a string", 8);
+  variable * var = init_variable("v", str, STRING);
+  variable * before = var;
+  assert(var->string_value == str && str->refs == 2);
+  set_variable(var, &d, DOUBLE);
+  assert(var == before && var->type == DOUBLE && var->value.double_value
+      == 2.5 && str->refs == 1);
+  set_variable(var, str, STRING);
+  assert(var->string_value == str && str->refs == 2);
+  release_shared_string(str);
+  assert(str->refs == 1 && !strcmp(var->string_value->data, "a string"));
+  free_variable(var);
+}
+
+int main(void) {
+  symbol_table_test();
+  symbol_table_growth_test();
+  symbol_table_slot_test();
+  variable_in_place_test();
+  printf("symbol_table_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,204 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../../src/lexer/include/lexer.h"
+#include "../../src/parser/include/parser.h"
+#include "../../src/parser/include/type_check.h"
+#include "../../src/vm/include/vm.h"
+
+/**
+ * This function parses, resolves and (if asked) type checks a line and
+ * compiles it to bytecode.
+ * @param    src - The line to be compiled.
+ * @param     tb - The token buffer to lex into.
+ * @param      a - The arena the tree and the chunk are allocated from.
+ * @param layout - The frame layout the variables are resolved to.
+ * @param    env - The types of the variables before the line (NULL for no
+ *                 type checking, so every operator is checked as it runs).
+ * @return    .\ - The chunk of the line.
+ */
+chunk * compile_line(const char * src, token_buffer * tb, arena * a,
+    symbol_table * layout, type_env * env) {
+  lexer * lex = init_lexer(src, strlen(src));
+  type_error err = {0};
+  ast * abstree = NULL;
+  lex_source(lex, tb);
+  abstree = parse_expression(tb, a);
+  free_lexer(lex);
+  resolve_tree(abstree, layout);
+  if(env)
+    assert(type_check_tree(abstree, env, &err));
+  return compile_tree(abstree, a);
+}
+
+/**
+ * This function compiles and runs a line on a vm.
+ * @param    src - The line to be run.
+ * @param     tb - The token buffer to lex into.
+ * @param      a - The arena the tree and the chunk are allocated from.
+ * @param layout - The frame layout the variables are resolved to.
+ * @param    env - The types of the variables before the line (or NULL).
+ * @param     st - The frame.
+ * @param      v - The vm.
+ * @return    .\ - The value of the line.
+ */
+ast_result run_line(const char * src, token_buffer * tb, arena * a,
+    symbol_table * layout, type_env * env, symbol_table ** st, vm * v) {
+  chunk * ch = compile_line(src, tb, a, layout, env);
+  bind_symbol_table(st[0], layout);
+  return run_chunk(v, ch, st);
+}
+
+/**
+ * This function determines whether a chunk contains an opcode.
+ * @param ch - The chunk.
+ * @param op - The opcode.
+ * @return .\ - 1 if it does, 0 otherwise.
+ */
+int chunk_has(chunk * ch, opcode op) {
+  for(int i = 0; i < ch->qty_code; i++)
+    if(ch->code[i].op == op)
+      return 1;
+  return 0;
+}
+
+/**
+ * This function tests that compiled lines give the values the tree walker
+ * does, with and without the opcodes for known operand types.
+ * @param  N/a
+ * @return N/a
+ */
+void vm_run_test(void) {
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  symbol_table * layout = init_symbol_table();
+  symbol_table * st = init_symbol_table();
+  type_env * env = init_type_env();
+  vm * v = init_vm();
+  chunk * ch = NULL;
+  ast_result r = run_line("x = 3", tb, a, layout, env, &st, v);
+  assert(r.type == INT && r.value.int_value == 1);
+  r = run_line("x * 2 + 7 / 2", tb, a, layout, env, &st, v);
+  assert(r.type == INT && r.value.int_value == 9);
+  r = run_line("y = 0.5", tb, a, layout, env, &st, v);
+  r = run_line("x / 2.0 - y ^ 2.0", tb, a, layout, env, &st, v);
+  assert(r.type == DOUBLE && r.value.double_value == 1.25);
+  r = run_line("x + y", tb, a, layout, env, &st, v);
+  assert(r.type == DOUBLE && r.value.double_value == 3.5);
+  r = run_line("x > y", tb, a, layout, NULL, &st, v);
+  assert(r.type == INT && r.value.int_value == 1);
+  r = run_line("sin(0.0) + log(1.0)", tb, a, layout, NULL, &st, v);
+  assert(r.type == DOUBLE && r.value.double_value == 0.0);
+  r = run_line("s = \"a\" + \"b\"", tb, a, layout, NULL, &st, v);
+  r = run_line("s == \"ab\"", tb, a, layout, NULL, &st, v);
+  assert(r.type == INT && r.value.int_value == 1);
+  // Typed operands get the in place opcodes, the others the checked ones
+  assert(chunk_has(compile_line("x * 2", tb, a, layout, env), OP_MUL_II));
+  assert(chunk_has(compile_line("y - 1.0", tb, a, layout, env), OP_SUB_DD));
+  assert(chunk_has(compile_line("x * 2", tb, a, layout, NULL), OP_MUL));
+  // The chunk is emitted from the flat tree: one instruction per node (the
+  // target of an assignment is not one) and OP_RETURN
+  ch = compile_line("1 + 2 * (3 - x)", tb, a, layout, env);
+  assert(ch->qty_code == 8 && ch->max_stack == 4);
+  ch = compile_line("y = (1.5 * y) + sin(y)", tb, a, layout, env);
+  assert(ch->qty_code == 8 && ch->max_stack == 2
+      && ch->code[6].op == OP_STORE_SLOT);
+  free_type_env(env);
+  free_vm(v);
+  free_symbol_table(st);
+  free_symbol_table(layout);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+/**
+ * This function tests that INT operations wrap around on overflow, that
+ * LLONG_MIN / -1 is LLONG_MIN and that DOUBLEs out of the range of an INT
+ * truncate to LLONG_MIN, with the in place opcodes and the checked ones.
+ * @param  N/a
+ * @return N/a
+ */
+void vm_int_edge_test(void) {
+  const char * lines[] = {"m + 1", "n - 1", "m * m", "n / k", "log(z)",
+    "10 ^ 30", "sin(m)"};
+  long long expected[] = {LLONG_MIN, LLONG_MAX, 1, LLONG_MIN, LLONG_MIN,
+    LLONG_MIN, (long long)sin(9223372036854775807.0)};
+  arena * a = init_arena();
+  token_buffer * tb = init_token_buffer();
+  symbol_table * layout = init_symbol_table();
+  symbol_table * st = init_symbol_table();
+  type_env * env = init_type_env();
+  vm * v = init_vm();
+  ast_result r = {0};
+  run_line("m = 9223372036854775807", tb, a, layout, env, &st, v);
+  run_line("n = 0 - m - 1", tb, a, layout, env, &st, v);
+  run_line("k = 0 - 1", tb, a, layout, env, &st, v);
+  run_line("z = 0", tb, a, layout, env, &st, v);
+  for(int i = 0; i < 7; i++) {
+    r = run_line(lines[i], tb, a, layout, env, &st, v);
+    assert(r.type == INT && r.value.int_value == expected[i]);
+    r = run_line(lines[i], tb, a, layout, NULL, &st, v);
+    assert(r.type == INT && r.value.int_value == expected[i]);
+  }
+  assert(chunk_has(compile_line("m + 1", tb, a, layout, env), OP_ADD_II));
+  assert(int_div(LLONG_MIN, -1) == LLONG_MIN && int_div(7, -1) == -7);
+  assert(double_to_int(NAN) == LLONG_MIN && double_to_int(-1.5) == -1);
+  free_type_env(env);
+  free_vm(v);
+  free_symbol_table(st);
+  free_symbol_table(layout);
+  free_token_buffer(tb);
+  free_arena(a);
+}
+
+/**
+ * This function runs a line in a child process (with nothing type checked)
+ * and tells whether it stopped the program.
+ * @param prelude - A line run before it (or NULL).
+ * @param     src - The line.
+ * @return     .\ - 1 if the child exited with status 1, 0 otherwise.
+ */
+int line_exits(const char * prelude, const char * src) {
+  int status = 0;
+  pid_t pid = fork();
+  if(pid == 0) {
+    arena * a = init_arena();
+    token_buffer * tb = init_token_buffer();
+    symbol_table * layout = init_symbol_table();
+    symbol_table * st = init_symbol_table();
+    vm * v = init_vm();
+    freopen("/dev/null", "w", stderr);
+    if(prelude)
+      run_line(prelude, tb, a, layout, NULL, &st, v);
+    run_line(src, tb, a, layout, NULL, &st, v);
+    _exit(0);
+  }
+  waitpid(pid, &status, 0);
+  return WIFEXITED(status) && WEXITSTATUS(status) == 1;
+}
+
+/**
+ * This function tests that the errors of the checked opcodes stop the
+ * program.
+ * @param  N/a
+ * @return N/a
+ */
+void vm_error_test(void) {
+  assert(line_exits("s = \"a\"", "s * 2"));
+  assert(line_exits("s = \"a\"", "s + 1"));
+  assert(line_exits("n = 0", "1 / n"));
+  assert(line_exits(NULL, "log(\"a\")"));
+  assert(line_exits(NULL, "u + 1"));
+  assert(!line_exits("n = 2", "1 / n"));
+}
+
+int main(void) {
+  vm_run_test();
+  vm_int_edge_test();
+  vm_error_test();
+  free_intern_table();
+  printf("vm_test: passed\n");
+  return 0;
+}